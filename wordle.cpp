@@ -1,39 +1,456 @@
 #include <bit>
 #include <cassert>
+#include <cmath>
 #include <string>
 #include <vector>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <unordered_set>
+#include <set>
+#include <memory>
 #include <stdexcept>
 #include <unordered_map>
 #include <algorithm>
 #include <array>
 #include <random>
-
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <optional>
+#include <span>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+
+#include "wordle.h"
+
+/*     -DWORDLE_LIBRARY builds libwordle.so: no Catch, no tests, no main()     */
+#ifndef WORDLE_LIBRARY
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
+#endif
 
 // ============== Starter code and helpers below =============
 
-// This function gives you words of length 5 in a dictionary.
+/* ========================= WORD LIST INGEST ========================= */
 
-std::unordered_set<std::string> GetAllValidWords() {
-  std::unordered_set<std::string> words;
-  std::ifstream word_file("/home/coderpad/data/words.txt"); 
-  
+/*
+  Source word lists can be hundreds of MB with mixed lengths, CRLF endings and mixed case.
+  loadWordBuckets() maps the file, splits it into newline-aligned chunks parsed in parallel,
+  normalizes (trim, case fold) and validates (letters only, see Alphabet) each line, and buckets
+  words by length. Short words are kept as packed keys of dense letter codes (5 bits each for
+  a-z) so deduplication is a sort + unique on integers; longer words fall back to strings.
+*/
+
+/*     sorted, deduplicated words per length     */
+using WordBuckets = std::map<size_t, std::vector<std::string>>;
+
+constexpr size_t kMaxPackedLetters = 12; // at 5 bits per letter in a uint64_t
+
+/* ---------------- alphabet ---------------- */
+
+/*
+  Letters get dense codes so letter tables and bitsets are sized to the alphabet rather than to
+  256 chars. a-z are codes 0-25 and are their own ASCII byte inside words. Any other letter the
+  loader accepts (case-folded UTF-8 from Latin-1, Latin Extended-A/B, IPA, Greek and Cyrillic) is
+  added to the word list's Alphabet under the next code, and inside words it is the single byte
+  0x80 + (code - 26), so a 5-letter word is still a 5-char std::string and every byte-level fast
+  path works unchanged. The unit -> code mapping doesn't depend on any alphabet (letterCode()),
+  only what a code stands for does: every DictionaryEpoch owns the Alphabet its words are
+  encoded in, and encodeWord()/decodeWord() convert to and from UTF-8 at the edges.
+*/
+constexpr size_t kMaxLetters = 64; // letter sets are one uint64_t
+constexpr size_t kAsciiLetters = 26;
+constexpr uint8_t kNoLetter = 0xff;
+
+/*     letterCode() -> code of a word unit, kNoLetter for bytes no alphabet uses     */
+inline uint8_t letterCode(char unit) {
+  unsigned char byte = static_cast<unsigned char>(unit);
+  if (byte >= 'a' && byte <= 'z') return static_cast<uint8_t>(byte - 'a');
+  if (byte >= 0x80 && byte < 0x80 + (kMaxLetters - kAsciiLetters)) return static_cast<uint8_t>(byte - 0x80 + kAsciiLetters);
+  return kNoLetter;
+}
+
+/*     letters of one word list: code -> folded code point, a-z plus whatever the list added     */
+class Alphabet {
+  public:
+    Alphabet(); // ctor, a-z
+    size_t size() const { return size_; }
+    bool has(char unit) const { return letterCode(unit) < size_; } // "unit" is one of these letters
+    static char unit(uint8_t code) { return static_cast<char>(code < kAsciiLetters ? 'a' + code : 0x80 + (code - kAsciiLetters)); }
+    uint32_t codePoint(uint8_t code) const { return codePoints_[code]; }
+    std::optional<uint8_t> find(uint32_t codePoint) const; // folded code point -> code
+    uint8_t add(uint32_t codePoint); // find(), adding the letter if it's new; throws once kMaxLetters are taken
+    bool extends(const Alphabet & older) const; // every letter of "older" has the same code here
+  private:
+    std::array<uint32_t, kMaxLetters> codePoints_{}; // code -> folded code point
+    size_t size_{kAsciiLetters};
+};
+
+Alphabet::Alphabet() {
+  for (size_t code = 0; code < kAsciiLetters; ++code) codePoints_[code] = 'a' + code;
+}
+
+std::optional<uint8_t> Alphabet::find(uint32_t codePoint) const {
+  if (codePoint >= 'a' && codePoint <= 'z') return static_cast<uint8_t>(codePoint - 'a');
+  for (size_t code = kAsciiLetters; code < size_; ++code) {
+    if (codePoints_[code] == codePoint) return static_cast<uint8_t>(code);
+  }
+  return std::nullopt;
+}
+
+uint8_t Alphabet::add(uint32_t codePoint) {
+  if (auto known = find(codePoint)) return *known;
+  if (size_ == kMaxLetters) throw std::logic_error{"Alphabet is full (" + std::to_string(kMaxLetters) + " letters)."};
+  codePoints_[size_] = codePoint;
+  return static_cast<uint8_t>(size_++);
+}
+
+bool Alphabet::extends(const Alphabet & older) const {
+  return older.size_ <= size_ && std::equal(older.codePoints_.begin(), older.codePoints_.begin() + older.size_, codePoints_.begin());
+}
+
+/*     Latin Extended-B capitals outside the regular runs in foldLetter() -> lowercase, sorted     */
+constexpr std::pair<uint16_t, uint16_t> kLatinExtendedBFolds[] = {
+  {0x181, 0x253}, {0x182, 0x183}, {0x184, 0x185}, {0x186, 0x254}, {0x187, 0x188}, {0x189, 0x256}, {0x18a, 0x257}, {0x18b, 0x18c},
+  {0x18e, 0x1dd}, {0x18f, 0x259}, {0x190, 0x25b}, {0x191, 0x192}, {0x193, 0x260}, {0x194, 0x263}, {0x196, 0x269}, {0x197, 0x268},
+  {0x198, 0x199}, {0x19c, 0x26f}, {0x19d, 0x272}, {0x19f, 0x275}, {0x1a0, 0x1a1}, {0x1a2, 0x1a3}, {0x1a4, 0x1a5}, {0x1a6, 0x280},
+  {0x1a7, 0x1a8}, {0x1a9, 0x283}, {0x1ac, 0x1ad}, {0x1ae, 0x288}, {0x1af, 0x1b0}, {0x1b1, 0x28a}, {0x1b2, 0x28b}, {0x1b3, 0x1b4},
+  {0x1b5, 0x1b6}, {0x1b7, 0x292}, {0x1b8, 0x1b9}, {0x1bc, 0x1bd}, {0x1c4, 0x1c6}, {0x1c5, 0x1c6}, {0x1c7, 0x1c9}, {0x1c8, 0x1c9},
+  {0x1ca, 0x1cc}, {0x1cb, 0x1cc}, {0x1f1, 0x1f3}, {0x1f2, 0x1f3}, {0x1f4, 0x1f5}, {0x1f6, 0x195}, {0x1f7, 0x1bf}, {0x220, 0x19e},
+  {0x23b, 0x23c}, {0x23d, 0x19a}, {0x241, 0x242}, {0x243, 0x180}, {0x244, 0x289}, {0x245, 0x28c},
+};
+
+/*     Greek capitals outside the regular runs in foldLetter() (tonos capitals, archaic and symbol forms) -> lowercase, sorted     */
+constexpr std::pair<uint16_t, uint16_t> kGreekFolds[] = {
+  {0x37f, 0x3f3}, {0x386, 0x3ac}, {0x388, 0x3ad}, {0x389, 0x3ae}, {0x38a, 0x3af}, {0x38c, 0x3cc}, {0x38e, 0x3cd}, {0x38f, 0x3ce},
+  {0x3cf, 0x3d7}, {0x3f4, 0x3b8}, {0x3f7, 0x3f8}, {0x3f9, 0x3f2}, {0x3fa, 0x3fb}, {0x3fd, 0x37b}, {0x3fe, 0x37c}, {0x3ff, 0x37d},
+};
+
+/*     foldLetter() -> lowercase of a code point the loader accepts as a letter, 0 for anything else     */
+uint32_t foldLetter(uint32_t cp) {
+  if (cp >= 'a' && cp <= 'z') return cp;
+  if (cp >= 'A' && cp <= 'Z') return cp - 'A' + 'a';
+  if (cp < 0xc0 || cp == 0xd7 || cp == 0xf7 || cp > 0x4ff || (cp > 0x2af && cp < 0x370)) return 0;
+
+  if (cp <= 0xde) return cp + 0x20; // Latin-1
+  if (cp == 0x178) return 0xff;
+  if ((cp >= 0x100 && cp <= 0x137) || (cp >= 0x14a && cp <= 0x177)) return cp | 1; // Latin Extended-A: upper even, lower odd
+  if ((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17e)) return cp + (cp & 1); // upper odd, lower even
+  if (cp >= 0x1cd && cp <= 0x1dc) return cp + (cp & 1); // Latin Extended-B, pinyin vowels: upper odd, lower even
+  if ((cp >= 0x1de && cp <= 0x1ef) || (cp >= 0x1f8 && cp <= 0x21f) || (cp >= 0x222 && cp <= 0x233) || (cp >= 0x246 && cp <= 0x24f)) return cp | 1;
+  if (cp >= 0x180 && cp <= 0x24f) {
+    /*     the rest pairs up irregularly (Ⱥ, Ⱦ fold outside the accepted blocks and stay as they are)     */
+    auto found = std::lower_bound(std::begin(kLatinExtendedBFolds), std::end(kLatinExtendedBFolds), cp, [](const auto & fold, uint32_t key) { return fold.first < key; });
+    return found != std::end(kLatinExtendedBFolds) && found->first == cp ? found->second : cp;
+  }
+
+  /*     Greek: numeral signs, ypogegrammeni, ; and ·, the spacing tonos/dialytika, unassigned code points and ϶ aren't letters     */
+  if (cp == 0x374 || cp == 0x375 || cp == 0x378 || cp == 0x379 || cp == 0x37a || cp == 0x37e || (cp >= 0x380 && cp <= 0x385)
+      || cp == 0x387 || cp == 0x38b || cp == 0x38d || cp == 0x3a2 || cp == 0x3f6) {
+    return 0;
+  }
+  if (cp >= 0x391 && cp <= 0x3ab) return cp + 0x20; // Α-Ω, Ϊ, Ϋ
+  if ((cp >= 0x370 && cp <= 0x373) || cp == 0x376 || (cp >= 0x3d8 && cp <= 0x3ef)) return cp | 1; // upper even, lower odd
+  if (cp >= 0x370 && cp <= 0x3ff) {
+    auto found = std::lower_bound(std::begin(kGreekFolds), std::end(kGreekFolds), cp, [](const auto & fold, uint32_t key) { return fold.first < key; });
+    return found != std::end(kGreekFolds) && found->first == cp ? found->second : cp;
+  }
+
+  /*     Cyrillic: ҂ and the combining titlo/palatalization/enclosing marks aren't letters     */
+  if (cp >= 0x482 && cp <= 0x489) return 0;
+  if (cp >= 0x410 && cp <= 0x42f) return cp + 0x20;
+  if (cp >= 0x400 && cp <= 0x40f) return cp + 0x50;
+  if ((cp >= 0x460 && cp <= 0x481) || (cp >= 0x48a && cp <= 0x4bf) || (cp >= 0x4d0 && cp <= 0x4ff)) return cp | 1; // Ѡ-Ҁ, Ҋ-Ҿ (Ґ), Ӑ-Ӿ: upper even, lower odd
+  if (cp == 0x4c0) return 0x4cf; // Ӏ
+  if (cp >= 0x4c1 && cp <= 0x4ce) return cp + (cp & 1); // Ӂ-Ӎ: upper odd, lower even
+  return cp;
+}
+
+/*     smallest code point that needs 1, 2 or 3 continuation bytes; anything below is an overlong form     */
+constexpr std::array<uint32_t, 4> kUtf8MinCodePoint = {0, 0x80, 0x800, 0x10000};
+
+/*     decodeLetter() -> next UTF-8 character of [c, end), folded (0 if not a letter or not well-formed UTF-8), advancing c     */
+uint32_t decodeLetter(const char *& c, const char * end) {
+  unsigned char lead = static_cast<unsigned char>(*c++);
+  if (lead < 0x80) return foldLetter(lead);
+
+  size_t extra = lead >= 0xf0 ? 3 : (lead >= 0xe0 ? 2 : (lead >= 0xc0 ? 1 : 0));
+  if (extra == 0 || lead >= 0xf5 || end - c < static_cast<std::ptrdiff_t>(extra)) return 0;
+  uint32_t cp = lead & (0x3f >> extra);
+  for (size_t idx = 0; idx < extra; ++idx) {
+    unsigned char next = static_cast<unsigned char>(*c);
+    if ((next & 0xc0) != 0x80) return 0;
+    cp = (cp << 6) | (next & 0x3f);
+    ++c;
+  }
+
+  /*     overlong forms (C0 81 = 'A'), surrogates and anything past U+10FFFF never decode to a letter     */
+  if (cp < kUtf8MinCodePoint[extra] || (cp >= 0xd800 && cp <= 0xdfff) || cp > 0x10ffff) return 0;
+  return foldLetter(cp);
+}
+
+/*     encodeWord() -> UTF-8 word in units of "letters" (throws on letters it doesn't have)     */
+std::string encodeWord(const std::string & utf8, const Alphabet & letters) {
+  std::string word;
+  for (const char * c = utf8.data(); c < utf8.data() + utf8.size();) {
+    uint32_t cp = decodeLetter(c, utf8.data() + utf8.size());
+    std::optional<uint8_t> code = cp == 0 ? std::nullopt : letters.find(cp);
+    if (!code) throw std::logic_error{"Word " + utf8 + " has a letter outside the alphabet."};
+    word.push_back(Alphabet::unit(*code));
+  }
+  return word;
+}
+
+/*     decodeWord() -> units of "letters" back to UTF-8, bytes that aren't letters pass through     */
+std::string decodeWord(const std::string & word, const Alphabet & letters) {
+  std::string utf8;
+  for (char unit : word) {
+    uint32_t cp = letters.has(unit) ? letters.codePoint(letterCode(unit)) : static_cast<unsigned char>(unit);
+    if (cp < 0x80) {
+      utf8.push_back(static_cast<char>(cp));
+    } else if (cp < 0x800) {
+      utf8.push_back(static_cast<char>(0xc0 | (cp >> 6)));
+      utf8.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+    } else {
+      utf8.push_back(static_cast<char>(0xe0 | (cp >> 12)));
+      utf8.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3f)));
+      utf8.push_back(static_cast<char>(0x80 | (cp & 0x3f)));
+    }
+  }
+  return utf8;
+}
+
+/*     read-only view of a whole file, mmap'ed when possible     */
+class MappedFile {
+  public:
+    explicit MappedFile(const std::string & path); // ctor, isOpen() is false if the file can't be read
+    ~MappedFile(); // dtor
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+    bool isOpen() const { return open_; }
+    const char * data() const { return mapped_ != nullptr ? mapped_ : fallback_.data(); }
+    size_t size() const { return size_; }
+  private:
+    bool open_{false};
+    const char * mapped_{nullptr};
+    size_t size_{0};
+    std::string fallback_; // used for empty files and anything mmap refuses
+};
+
+MappedFile::MappedFile(const std::string & path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd >= 0) {
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      void * addr = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+        ::madvise(addr, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+        mapped_ = static_cast<const char *>(addr);
+        size_ = static_cast<size_t>(info.st_size);
+        open_ = true;
+      }
+    }
+    ::close(fd);
+  }
+  if (open_) return;
+
+  std::ifstream word_file(path, std::ios::binary);
   if (word_file.is_open()) {
-    std::string word;
-    
-    while (std::getline(word_file, word)) {
-      if(word.size() == 5) words.insert(word); 
+    fallback_.assign(std::istreambuf_iterator<char>(word_file), std::istreambuf_iterator<char>());
+    size_ = fallback_.size();
+    open_ = true;
+  }
+}
+
+MappedFile::~MappedFile() {
+  if (mapped_ != nullptr) ::munmap(const_cast<char *>(mapped_), size_);
+}
+
+/*     runs fn(i) for i in [0, n) on up to "threads" threads     */
+void parallelFor(size_t n, size_t threads, const std::function<void(size_t)> & fn) {
+  threads = std::max<size_t>(1, std::min(threads, n));
+  std::atomic<size_t> next{0};
+  auto work = [&]() {
+    for (size_t i = next++; i < n; i = next++) fn(i);
+  };
+  std::vector<std::thread> pool;
+  for (size_t t = 1; t < threads; ++t) pool.emplace_back(work);
+  work();
+  for (auto & thread : pool) thread.join();
+}
+
+/*     words of one chunk, by length     */
+struct ChunkWords {
+  std::array<std::vector<uint64_t>, kMaxPackedLetters + 1> packed; // index = length
+  std::map<size_t, std::vector<std::string>> unpacked; // too long to pack
+  std::set<uint32_t> letters; // non-ASCII letters of valid words (scan pass only)
+};
+
+/*     packed key sorts like the word: first letter in the high bits, code + 1 per letter     */
+std::string unpackWordKey(uint64_t key, size_t length, unsigned bits = 5) {
+  std::string word(length, ' ');
+  for (size_t idx = length; idx-- > 0;) {
+    word[idx] = Alphabet::unit(static_cast<uint8_t>((key & ((uint64_t{1} << bits) - 1)) - 1));
+    key >>= bits;
+  }
+  return word;
+}
+
+/*     calls fn(first, last) for every trimmed, non-empty line of [begin, end)     */
+template <class Fn>
+void forEachLine(const char * begin, const char * end, Fn fn) {
+  while (begin < end) {
+    const char * lineEnd = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+    if (lineEnd == nullptr) lineEnd = end;
+
+    /*     trim spaces, tabs and the '\r' of CRLF files     */
+    const char * first = begin;
+    const char * last = lineEnd;
+    while (first < last && (*first == ' ' || *first == '\t' || *first == '\r')) ++first;
+    while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r')) --last;
+    begin = lineEnd + 1;
+
+    if (last > first) fn(first, last);
+  }
+}
+
+/*     scanLetters() -> non-ASCII letters used by the valid words of a chunk (nothing to do for ASCII-only chunks)     */
+void scanLetters(const char * begin, const char * end, ChunkWords & out) {
+  if (std::none_of(begin, end, [](char c) { return static_cast<unsigned char>(c) >= 0x80; })) return;
+  forEachLine(begin, end, [&](const char * first, const char * last) {
+    std::vector<uint32_t> found;
+    for (const char * c = first; c < last;) {
+      uint32_t cp = decodeLetter(c, last);
+      if (cp == 0) return;
+      if (cp >= 0x80) found.push_back(cp);
     }
-    
-    word_file.close();
+    out.letters.insert(found.begin(), found.end());
+  });
+}
+
+/*     parseChunk() -> fold, validate and pack every line; "bits" per letter code, every letter already in "letters"     */
+void parseChunk(const char * begin, const char * end, ChunkWords & out, const Alphabet & letters, unsigned bits = 5) {
+  const size_t maxPacked = std::min<size_t>(kMaxPackedLetters, 64 / bits);
+  forEachLine(begin, end, [&](const char * first, const char * last) {
+    uint64_t key = 0;
+    size_t length = 0;
+    for (const char * c = first; c < last; ++length) {
+      uint32_t cp = decodeLetter(c, last);
+      std::optional<uint8_t> code = cp == 0 ? std::nullopt : (cp < 0x80 ? std::optional<uint8_t>(cp - 'a') : letters.find(cp));
+      if (!code) return;
+      key = (key << bits) | static_cast<uint64_t>(*code + 1);
+    }
+
+    if (length <= maxPacked) {
+      out.packed[length].push_back(key);
+    } else {
+      out.unpacked[length].push_back(encodeWord(std::string(first, last), letters));
+    }
+  });
+}
+
+/*
+  loadWordBuckets() -> every valid word in "path", bucketed by length, in units of "letters". New letters are added
+  to "letters"; if they don't fit, "letters" starts over with only the letters of this file, so words encoded
+  in the old alphabet must not be decoded with it
+*/
+WordBuckets loadWordBuckets(const std::string & path, Alphabet & letters, size_t threads = std::thread::hardware_concurrency(), size_t minChunkBytes = size_t{1} << 20) {
+  WordBuckets buckets;
+  MappedFile file{path};
+  if (!file.isOpen() || file.size() == 0) return buckets;
+
+  /*     newline-aligned chunks     */
+  threads = std::max<size_t>(threads, 1);
+  size_t numChunks = std::max<size_t>(1, std::min(threads * 4, file.size() / std::max<size_t>(minChunkBytes, 1)));
+  std::vector<const char *> cuts{file.data()};
+  const char * end = file.data() + file.size();
+  for (size_t chunk = 1; chunk < numChunks; ++chunk) {
+    const char * cut = std::max(cuts.back(), file.data() + chunk * (file.size() / numChunks));
+    const char * newline = static_cast<const char *>(std::memchr(cut, '\n', end - cut));
+    cuts.push_back(newline == nullptr ? end : newline + 1);
   }
-  return words;
+  cuts.push_back(end);
+
+  std::vector<ChunkWords> chunks(cuts.size() - 1);
+
+  /*     add new letters first (in code point order, so codes don't depend on chunking), then size keys to the alphabet     */
+  parallelFor(chunks.size(), threads, [&](size_t chunk) { scanLetters(cuts[chunk], cuts[chunk + 1], chunks[chunk]); });
+  std::set<uint32_t> used;
+  for (ChunkWords & chunk : chunks) used.merge(chunk.letters);
+  size_t missing = std::count_if(used.begin(), used.end(), [&](uint32_t cp) { return !letters.find(cp); });
+  if (letters.size() + missing > kMaxLetters) letters = Alphabet{};
+  for (uint32_t cp : used) letters.add(cp); // throws if the file alone has too many letters
+  const unsigned bits = static_cast<unsigned>(std::bit_width(letters.size()));
+
+  parallelFor(chunks.size(), threads, [&](size_t chunk) { parseChunk(cuts[chunk], cuts[chunk + 1], chunks[chunk], letters, bits); });
+
+  /*     merge + sort/unique per length     */
+  std::vector<size_t> lengths;
+  for (size_t length = 1; length <= kMaxPackedLetters; ++length) {
+    for (const ChunkWords & chunk : chunks) {
+      if (!chunk.packed[length].empty()) {
+        lengths.push_back(length);
+        break;
+      }
+    }
+  }
+  std::vector<std::vector<std::string>> merged(lengths.size());
+  parallelFor(lengths.size(), threads, [&](size_t idx) {
+    size_t length = lengths[idx];
+    std::vector<uint64_t> keys;
+    for (ChunkWords & chunk : chunks) {
+      keys.insert(keys.end(), chunk.packed[length].begin(), chunk.packed[length].end());
+      std::vector<uint64_t>().swap(chunk.packed[length]);
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    merged[idx].reserve(keys.size());
+    for (uint64_t key : keys) merged[idx].push_back(unpackWordKey(key, length, bits));
+  });
+  for (size_t idx = 0; idx < lengths.size(); ++idx) buckets[lengths[idx]] = std::move(merged[idx]);
+
+  for (ChunkWords & chunk : chunks) {
+    for (auto & entry : chunk.unpacked) {
+      auto & words = buckets[entry.first];
+      words.insert(words.end(), std::make_move_iterator(entry.second.begin()), std::make_move_iterator(entry.second.end()));
+    }
+  }
+  for (auto & entry : buckets) {
+    if (entry.first <= std::min<size_t>(kMaxPackedLetters, 64 / bits)) continue;
+    std::sort(entry.second.begin(), entry.second.end());
+    entry.second.erase(std::unique(entry.second.begin(), entry.second.end()), entry.second.end());
+  }
+
+  return buckets;
 }
 
+const std::string kDictionaryPath = "/home/coderpad/data/words.txt";
+
+// This function gives you words of length 5 in a dictionary.
+
+std::unordered_set<std::string> GetAllValidWords(); // words of the current DictionaryEpoch, see below
+
 
 /* ===================== LETTER STATES ===================== */
 
@@ -53,13 +470,18 @@ std::ostream& operator<<(std::ostream& os, const WordleLetterStates& states);
 
 /* ================== WORDLE GAME CLASS ================== */
 
+class DictionaryEpoch;
+std::shared_ptr<const DictionaryEpoch> currentDictionary();
+
 class Wordle {
   public:
-    explicit Wordle(std::string true_word) : true_word_{std::move(true_word)} {} // ctor
+    explicit Wordle(std::string true_word) : true_word_{std::move(true_word)}, dictionary_{currentDictionary()} {} // ctor
     ~Wordle(); // dtor
     WordleLetterStates CharacterizeWord(const std::string& query) const; // evaluate guess
+    const std::shared_ptr<const DictionaryEpoch> & dictionary() const { return dictionary_; } // word list this game plays by
   private:
     std::string true_word_; // target word
+    std::shared_ptr<const DictionaryEpoch> dictionary_; // captured at construction, survives reloads
     mutable size_t counter_{0}; // # of guesses
 };
 
@@ -656,11 +1078,455 @@ However in the real world, these assumptions do not always hold and its always i
 /* ========================= END OF NOTES ========================== */
 
 
+/* ================== WORD IDS + FEEDBACK CODES ================== */
+
+/*     dense ids for dictionary words, assigned in sorted order so the same word list always gives the same ids     */
+using WordId = uint32_t;
+constexpr WordId kInvalidWordId = std::numeric_limits<WordId>::max();
+
+/*     WordleLetterStates packed in base 3 (NOT_CONTAINED = 0, CONTAINED = 1, CORRECT = 2), index 0 is least significant     */
+using FeedbackCode = uint8_t;
+constexpr size_t kNumFeedbackCodes = 243;
+constexpr FeedbackCode kAllCorrect = 242;
+
+FeedbackCode encodeFeedback(const WordleLetterStates & states) {
+  int code = 0;
+  for (size_t idx = states.size(); idx-- > 0;) {
+    code *= 3;
+    if (states[idx] == CORRECT) code += 2;
+    else if (states[idx] == CONTAINED) code += 1;
+  }
+  return static_cast<FeedbackCode>(code);
+}
+
+WordleLetterStates decodeFeedback(FeedbackCode code) {
+  WordleLetterStates states;
+  int rest = code;
+  for (size_t idx = 0; idx < states.size(); ++idx) {
+    int digit = rest % 3;
+    rest /= 3;
+    states[idx] = digit == 2 ? CORRECT : (digit == 1 ? CONTAINED : NOT_CONTAINED);
+  }
+  return states;
+}
+
+class WordIndex {
+  public:
+    explicit WordIndex(const std::unordered_set<std::string> & words); // ctor, sorts words
+    explicit WordIndex(std::vector<std::string> sortedWords); // ctor, words already sorted and unique
+    WordId id(const std::string & word) const; // kInvalidWordId if not in dictionary
+    WordIndex patched(const std::vector<std::string> & added, const std::vector<std::string> & removed) const; // minus "removed" plus "added", both sorted
+    const std::string & word(WordId id) const { return words_[id]; }
+    const std::vector<std::string> & words() const { return words_; }
+    size_t size() const { return words_.size(); }
+    uint64_t fingerprint() const { return fingerprint_; } // identifies the word list in trace files
+  private:
+    std::vector<std::string> words_; // id -> word, sorted so an id is a binary search
+    uint64_t fingerprint_{0};
+};
+
+/*     patchSorted() -> walks sorted "words" minus sorted "removed", merged with sorted "added" (none of them in "words"): keep(id) or add(word), in order     */
+template <class Keep, class Add>
+void patchSorted(const std::vector<std::string> & words, const std::vector<std::string> & added, const std::vector<std::string> & removed, Keep keep, Add add) {
+  auto enter = added.begin();
+  auto leave = removed.begin();
+  for (size_t id = 0; id < words.size(); ++id) {
+    while (leave != removed.end() && *leave < words[id]) ++leave;
+    if (leave != removed.end() && *leave == words[id]) continue;
+    while (enter != added.end() && *enter < words[id]) add(*enter++);
+    keep(id);
+  }
+  while (enter != added.end()) add(*enter++);
+}
+
+WordIndex::WordIndex(const std::unordered_set<std::string> & words)
+  : WordIndex{[&]() {
+      std::vector<std::string> sorted(words.begin(), words.end());
+      std::sort(sorted.begin(), sorted.end());
+      return sorted;
+    }()} {}
+
+WordIndex::WordIndex(std::vector<std::string> sortedWords) : words_{std::move(sortedWords)} {
+  /*     FNV-1a over the sorted list     */
+  fingerprint_ = 14695981039346656037ull;
+  for (WordId id = 0; id < words_.size(); ++id) {
+    for (char c : words_[id]) {
+      fingerprint_ = (fingerprint_ ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    fingerprint_ = (fingerprint_ ^ '\n') * 1099511628211ull;
+  }
+}
+
+WordId WordIndex::id(const std::string & word) const {
+  auto it = std::lower_bound(words_.begin(), words_.end(), word);
+  return it == words_.end() || *it != word ? kInvalidWordId : static_cast<WordId>(it - words_.begin());
+}
+
+WordIndex WordIndex::patched(const std::vector<std::string> & added, const std::vector<std::string> & removed) const {
+  std::vector<std::string> words;
+  words.reserve(words_.size() + added.size() - std::min(removed.size(), words_.size()));
+  patchSorted(words_, added, removed, [&](size_t id) { words.push_back(words_[id]); }, [&](const std::string & word) { words.push_back(word); });
+  return WordIndex{std::move(words)};
+}
+
+
+/* ======================= DICTIONARY EPOCHS ======================= */
+
+/*
+  The word list is an immutable DictionaryEpoch published through an atomic shared_ptr (RCU-style):
+  games take the current epoch when they start and keep it alive until they finish, and
+  reloadDictionary() builds the next epoch off to the side and swaps it in, so a reload never
+  pauses or changes a game in flight. Each epoch carries the Alphabet its words are encoded in and
+  rejects words that aren't 5 of its letters, and picks its own opening guess (kOpeningGuess when
+  the list has it). Caches live on the epoch: the sorted word index, the default strategy (every
+  word of the epoch an allowed guess), the solver state after the opening guess, per feedback
+  code, and each strategy's memoized second guess from it. A reload only checks the added words
+  (when the new alphabet extends the old one), patches the index with the diff instead of
+  re-sorting, only rebuilds the cached openings that an added or removed word actually falls
+  into, and shares the rest with the previous epoch minus memoized guesses that are no longer
+  words (all of them are rebuilt if the opening guess changed). If the previous epoch's strategy
+  was built, the new one starts from its packed words patched with the diff; otherwise it is
+  built from the patched index on first use. What stays linear in the list is copying: ids are
+  positions in the sorted list (traces, sweep tables and the C API all key on them), so the
+  arrays are rewritten once per reload, with no hashing, packing or re-validation of kept words.
+*/
+
+struct OpeningBucket;
+class TieredStrategy;
+
+const std::string kOpeningGuess = "slate"; // preferred opening, for word lists that have it
+
+class DictionaryEpoch {
+  public:
+    DictionaryEpoch(std::unordered_set<std::string> words, uint64_t epoch, Alphabet letters = {}, const std::vector<std::string> * unchecked = nullptr); // ctor, "words" in units of "letters" (throws on anything else); only "unchecked" is checked if given
+    uint64_t epoch() const { return epoch_; }
+    const Alphabet & alphabet() const { return letters_; }
+    const std::unordered_set<std::string> & words() const { return words_; }
+    bool contains(const std::string & word) const { return words_.count(word) != 0; }
+    const std::string & openingGuess() const { return opening_; } // first guess of every game on this epoch
+    const WordIndex & index() const; // sorted ids for traces, built on first use
+    const TieredStrategy & strategy() const; // default strategy over this word list, built on first use
+    std::shared_ptr<const OpeningBucket> afterOpening(FeedbackCode code) const; // state after openingGuess(), built on first use
+    std::shared_ptr<const DictionaryEpoch> next(std::unordered_set<std::string> words, Alphabet letters) const; // next epoch, keeping every cache the diff doesn't touch
+  private:
+    void handOnStrategy(const DictionaryEpoch & next, const std::vector<std::string> & added, const std::vector<std::string> & removed) const; // next's strategy from ours patched, if ours was built
+    uint64_t epoch_;
+    Alphabet letters_;
+    std::unordered_set<std::string> words_;
+    std::string opening_;
+    mutable std::once_flag indexOnce_;
+    mutable std::shared_ptr<const WordIndex> index_;
+    mutable std::once_flag strategyOnce_;
+    mutable std::shared_ptr<const TieredStrategy> strategy_;
+    mutable std::atomic<bool> strategyBuilt_{false}; // strategy_ is set, next() may patch its scorer
+    mutable std::mutex mutex_; // guards openings_
+    mutable std::array<std::shared_ptr<const OpeningBucket>, kNumFeedbackCodes> openings_;
+};
+
+/*     pickOpening() -> kOpeningGuess if it's a word, else the frequency pick over the whole list in units of "letters" ("" for an empty one)     */
+std::string pickOpening(const std::unordered_set<std::string> & words, const Alphabet & letters);
+
+DictionaryEpoch::DictionaryEpoch(std::unordered_set<std::string> words, uint64_t epoch, Alphabet letters, const std::vector<std::string> * unchecked)
+  : epoch_{epoch}, letters_{letters}, words_{std::move(words)} {
+  auto check = [&](const std::string & word) {
+    if (word.size() != 5 || !std::all_of(word.begin(), word.end(), [&](char unit) { return letters_.has(unit); })) {
+      throw std::logic_error{"Word " + decodeWord(word, letters_) + " is not 5 letters of the alphabet."};
+    }
+  };
+  if (unchecked) {
+    std::for_each(unchecked->begin(), unchecked->end(), check);
+  } else {
+    std::for_each(words_.begin(), words_.end(), check);
+  }
+  opening_ = pickOpening(words_, letters_);
+}
+
+const WordIndex & DictionaryEpoch::index() const {
+  std::call_once(indexOnce_, [this]() { index_ = std::make_shared<const WordIndex>(words_); });
+  return *index_;
+}
+
+/*     the published epoch; readers load it, reloadDictionary() stores the next one     */
+std::atomic<std::shared_ptr<const DictionaryEpoch>> & dictionarySlot() {
+  static std::atomic<std::shared_ptr<const DictionaryEpoch>> slot{[]() {
+    Alphabet letters;
+    WordBuckets buckets = loadWordBuckets(kDictionaryPath, letters);
+    const std::vector<std::string> & words = buckets[5];
+    return std::make_shared<const DictionaryEpoch>(std::unordered_set<std::string>(words.begin(), words.end()), 0, letters);
+  }()};
+  return slot;
+}
+
+std::shared_ptr<const DictionaryEpoch> currentDictionary() {
+  return dictionarySlot().load();
+}
+
+/*     publishes "words" (in units of "letters") as the next epoch; games already running keep theirs     */
+std::shared_ptr<const DictionaryEpoch> reloadDictionary(std::unordered_set<std::string> words, Alphabet letters) {
+  static std::mutex writers;
+  std::lock_guard<std::mutex> lock{writers};
+  std::shared_ptr<const DictionaryEpoch> next = dictionarySlot().load()->next(std::move(words), letters);
+  dictionarySlot().store(next);
+  return next;
+}
+
+/*     same, "words" in units of the current epoch's alphabet     */
+std::shared_ptr<const DictionaryEpoch> reloadDictionary(std::unordered_set<std::string> words) {
+  return reloadDictionary(std::move(words), currentDictionary()->alphabet());
+}
+
+/*     new letters extend the current alphabet; a file that doesn't fit in it gets an alphabet of its own     */
+std::shared_ptr<const DictionaryEpoch> reloadDictionary(const std::string & path = kDictionaryPath) {
+  Alphabet letters = currentDictionary()->alphabet();
+  WordBuckets buckets = loadWordBuckets(path, letters);
+  const std::vector<std::string> & words = buckets[5];
+  return reloadDictionary(std::unordered_set<std::string>(words.begin(), words.end()), letters);
+}
+
+std::unordered_set<std::string> GetAllValidWords() {
+  return currentDictionary()->words();
+}
+
+
+/* ========================== GAME TRACES ========================== */
+
+/*
+  Binary trace of solved games (all integers little-endian):
+
+  header: "WTRC" | u16 version | u16 word length | u64 dictionary fingerprint | u32 dictionary size
+  game:   u32 answer id | u32 result id | u16 step count | steps...
+  step:   u32 guess id | u8 feedback code | u32 candidates before | u32 candidates after
+          | u32 characterize ns | u32 reduce ns | u32 pick ns
+
+  "pick ns" is the time spent choosing the guess that follows the step (0 for the last step).
+  Every game record is self-contained, so writers from many threads only need to serialize the
+  append itself. All ids are in the header's dictionary: TraceWriter refuses games played on any
+  other epoch (after a reload), so one file never mixes id spaces.
+*/
+
+struct TraceStep {
+  WordId guess{kInvalidWordId};
+  FeedbackCode feedback{0};
+  uint32_t candidatesBefore{0};
+  uint32_t candidatesAfter{0};
+  uint32_t characterizeNs{0};
+  uint32_t reduceNs{0};
+  uint32_t pickNs{0};
+};
+
+struct GameTrace {
+  uint64_t dictionary{0}; // fingerprint of the epoch the game played on, its ids are that epoch's (not serialized)
+  WordId answer{kInvalidWordId}; // set by caller, SolveWordle can't see the answer
+  WordId result{kInvalidWordId}; // word returned by SolveWordle
+  std::vector<TraceStep> steps;
+};
+
+constexpr char kTraceMagic[4] = {'W', 'T', 'R', 'C'};
+constexpr uint16_t kTraceVersion = 1;
+constexpr size_t kTraceHeaderBytes = 20;
+constexpr size_t kTraceStepBytes = 25;
+
+/*     nanoseconds since "start", saturated to fit a trace field     */
+uint32_t elapsedNs(std::chrono::steady_clock::time_point start) {
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  return static_cast<uint32_t>(std::min<long long>(ns, std::numeric_limits<uint32_t>::max()));
+}
+
+void appendLE(std::string & out, uint64_t value, size_t bytes) {
+  for (size_t idx = 0; idx < bytes; ++idx) {
+    out.push_back(static_cast<char>((value >> (8 * idx)) & 0xff));
+  }
+}
+
+uint64_t readLE(const unsigned char * data, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t idx = 0; idx < bytes; ++idx) {
+    value |= static_cast<uint64_t>(data[idx]) << (8 * idx);
+  }
+  return value;
+}
+
+std::string traceHeader(const WordIndex & index) {
+  std::string header(kTraceMagic, sizeof(kTraceMagic));
+  appendLE(header, kTraceVersion, 2);
+  appendLE(header, 5, 2);
+  appendLE(header, index.fingerprint(), 8);
+  appendLE(header, index.size(), 4);
+  return header;
+}
+
+void serializeGame(const GameTrace & game, std::string & out) {
+  if (game.steps.size() > std::numeric_limits<uint16_t>::max()) {
+    throw std::logic_error{"Game has " + std::to_string(game.steps.size()) + " steps, a trace record holds at most " + std::to_string(std::numeric_limits<uint16_t>::max()) + "."};
+  }
+  appendLE(out, game.answer, 4);
+  appendLE(out, game.result, 4);
+  appendLE(out, game.steps.size(), 2);
+  for (const TraceStep & step : game.steps) {
+    appendLE(out, step.guess, 4);
+    appendLE(out, step.feedback, 1);
+    appendLE(out, step.candidatesBefore, 4);
+    appendLE(out, step.candidatesAfter, 4);
+    appendLE(out, step.characterizeNs, 4);
+    appendLE(out, step.reduceNs, 4);
+    appendLE(out, step.pickNs, 4);
+  }
+}
+
+/*     appends games to a trace file, safe to share between threads     */
+class TraceWriter {
+  public:
+    TraceWriter(const std::string & path, const WordIndex & index); // ctor, writes or checks header
+    ~TraceWriter(); // dtor
+    TraceWriter(const TraceWriter &) = delete;
+    TraceWriter & operator=(const TraceWriter &) = delete;
+    void append(const GameTrace & game); // one fwrite + fflush per game, throws if the game played on another dictionary or the write fails
+  private:
+    std::string path_;
+    uint64_t fingerprint_;
+    std::FILE * file_{nullptr};
+    bool failed_{false}; // a write failed and may have left part of a record, nothing more is appended
+    std::mutex mutex_;
+};
+
+TraceWriter::TraceWriter(const std::string & path, const WordIndex & index) : path_{path}, fingerprint_{index.fingerprint()} {
+  const std::string header = traceHeader(index);
+
+  /*     appending to an existing trace is only valid for the same dictionary     */
+  if (std::FILE * existing = std::fopen(path.c_str(), "rb")) {
+    std::string found(kTraceHeaderBytes, '\0');
+    size_t got = std::fread(found.data(), 1, found.size(), existing);
+    std::fclose(existing);
+    if (got != 0 && (got != kTraceHeaderBytes || found != header)) {
+      throw std::logic_error{"Trace " + path + " was recorded with a different dictionary."};
+    }
+  }
+
+  file_ = std::fopen(path.c_str(), "ab");
+  if (file_ == nullptr) throw std::logic_error{"Could not open trace " + path};
+  long at = std::ftell(file_);
+  if (at < 0 || (at == 0 && (std::fwrite(header.data(), 1, header.size(), file_) != header.size() || std::fflush(file_) != 0))) {
+    std::fclose(file_);
+    throw std::logic_error{"Could not write the header of trace " + path};
+  }
+}
+
+TraceWriter::~TraceWriter() {
+  std::fclose(file_);
+}
+
+void TraceWriter::append(const GameTrace & game) {
+  if (game.dictionary != fingerprint_) throw std::logic_error{"Game was played on another dictionary than the trace's."};
+
+  /*     serialize outside the lock, only the write is serialized     */
+  std::string record;
+  record.reserve(10 + game.steps.size() * kTraceStepBytes);
+  serializeGame(game, record);
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (failed_) throw std::logic_error{"Trace " + path_ + " failed an earlier write."};
+  if (std::fwrite(record.data(), 1, record.size(), file_) != record.size() || std::fflush(file_) != 0) {
+    failed_ = true;
+    throw std::logic_error{"Could not write a game to trace " + path_};
+  }
+}
+
+/*     reads every game in a trace, throws if it belongs to another dictionary, is truncated or has ids/codes out of range     */
+std::vector<GameTrace> readTrace(const std::string & path, const WordIndex & index) {
+  std::ifstream trace_file(path, std::ios::binary);
+  if (!trace_file.is_open()) throw std::logic_error{"Could not open trace " + path};
+  std::string bytes{std::istreambuf_iterator<char>(trace_file), std::istreambuf_iterator<char>()};
+
+  if (bytes.compare(0, kTraceHeaderBytes, traceHeader(index)) != 0) {
+    throw std::logic_error{"Trace " + path + " was recorded with a different dictionary."};
+  }
+
+  const unsigned char * data = reinterpret_cast<const unsigned char *>(bytes.data());
+  size_t pos = kTraceHeaderBytes;
+  std::vector<GameTrace> games;
+  auto checkId = [&](WordId id) {
+    if (id >= index.size()) throw std::logic_error{"Word id " + std::to_string(id) + " is out of range in trace " + path};
+  };
+
+  while (pos < bytes.size()) {
+    if (bytes.size() - pos < 10) throw std::logic_error{"Truncated trace " + path};
+    GameTrace game;
+    game.answer = static_cast<WordId>(readLE(data + pos, 4));
+    game.result = static_cast<WordId>(readLE(data + pos + 4, 4));
+    size_t numSteps = readLE(data + pos + 8, 2);
+    pos += 10;
+    checkId(game.answer);
+    checkId(game.result);
+
+    if (bytes.size() - pos < numSteps * kTraceStepBytes) throw std::logic_error{"Truncated trace " + path};
+    game.steps.resize(numSteps);
+    for (TraceStep & step : game.steps) {
+      step.guess = static_cast<WordId>(readLE(data + pos, 4));
+      step.feedback = static_cast<FeedbackCode>(data[pos + 4]);
+      step.candidatesBefore = static_cast<uint32_t>(readLE(data + pos + 5, 4));
+      step.candidatesAfter = static_cast<uint32_t>(readLE(data + pos + 9, 4));
+      step.characterizeNs = static_cast<uint32_t>(readLE(data + pos + 13, 4));
+      step.reduceNs = static_cast<uint32_t>(readLE(data + pos + 17, 4));
+      step.pickNs = static_cast<uint32_t>(readLE(data + pos + 21, 4));
+      pos += kTraceStepBytes;
+      checkId(step.guess);
+      if (step.feedback >= kNumFeedbackCodes) throw std::logic_error{"Feedback code " + std::to_string(step.feedback) + " is out of range in trace " + path};
+    }
+    games.push_back(std::move(game));
+  }
+
+  return games;
+}
+
+
+
+/*     letters as a bitset over dense alphabet codes; chars outside the alphabet are never members     */
+class LetterSet {
+  public:
+    LetterSet() = default;
+    LetterSet(std::initializer_list<char> letters) { for (char letter : letters) insert(letter); } // ctor
+    void insert(char letter) { bits_ |= bit(letter); }
+    void erase(char letter) { bits_ &= ~bit(letter); }
+    bool count(char letter) const { return (bits_ & bit(letter)) != 0; }
+    size_t size() const { return static_cast<size_t>(std::popcount(bits_)); }
+    std::string letters() const; // members in code order
+  private:
+    static uint64_t bit(char letter) {
+      uint8_t code = letterCode(letter);
+      return code < kMaxLetters ? uint64_t{1} << code : 0;
+    }
+    uint64_t bits_{0};
+};
+
+std::string LetterSet::letters() const {
+  std::string out;
+  for (uint64_t rest = bits_; rest != 0; rest &= rest - 1) out.push_back(Alphabet::unit(static_cast<uint8_t>(std::countr_zero(rest))));
+  return out;
+}
+
+/*     letters known to be in the answer, each with the positions it's known not to be at     */
+struct ContainedLetters {
+  LetterSet letters;
+  std::array<uint8_t, kMaxLetters> notAt{}; // by letter code, bit p = not at position p
+
+  void insert(char letter, int pos) {
+    letters.insert(letter);
+    uint8_t code = letterCode(letter);
+    if (code < kMaxLetters) notAt[code] |= static_cast<uint8_t>(1u << pos);
+  }
+  bool count(char letter) const { return letters.count(letter); }
+  bool isNotAt(char letter, size_t pos) const { return letters.count(letter) && (notAt[letterCode(letter)] >> pos & 1); } // count() is false off the alphabet
+  size_t size() const { return letters.size(); }
+};
+
+/*     known letter per position, '\0' where unknown     */
+using CorrectLetters = std::array<char, 5>;
+
 /*     calculateLetterOverlap() -> calculates # of overlapping chars     */
-int calculateLetterOverlap(const std::string & word, const std::unordered_set<char> & guessedLetters) {
+int calculateLetterOverlap(const std::string & word, const LetterSet & guessedLetters) {
   int overlap = 0;
   for (char c: word) {
-    if (guessedLetters.find(c) != guessedLetters.end()) {
+    if (guessedLetters.count(c)) {
       overlap++;
     }
   }
@@ -669,7 +1535,7 @@ int calculateLetterOverlap(const std::string & word, const std::unordered_set<ch
 }
 
 /*     getNextGuess() -> get next best guess     */
-std::string getNextGuess(const std::unordered_set<std::string> & possibleAnswers, const std::unordered_set<char> & guessedLetters) {
+std::string getNextGuess(const std::unordered_set<std::string> & possibleAnswers, const LetterSet & guessedLetters) {
 
   int minOverlap = std::numeric_limits<int>::max();
   std::string leastLikelyWord;
@@ -689,26 +1555,26 @@ std::string getNextGuess(const std::unordered_set<std::string> & possibleAnswers
 }
 
 /*     remainingWords() -> reduce solution set     */
-void remainingWords(std::unordered_set<std::string> & possibleAnswers, std::unordered_map<char, std::unordered_set<int>> & contains, const std::unordered_set<char> & notContains,  std::unordered_map<int, char> & correct) { 
+void remainingWords(std::unordered_set<std::string> & possibleAnswers, const ContainedLetters & contains, const LetterSet & notContains, const CorrectLetters & correct) { 
   std::unordered_set<std::string> updatedPossibleAnswers; 
 
   /*     loop through solution set     */
   for (const std::string & word: possibleAnswers) {
-    std::unordered_set<char> containsInWord; 
+    LetterSet containsInWord; 
     bool shouldRemove = false; 
 
     /*     loop through chars     */
     for (size_t idx = 0; idx < word.size(); ++idx) {
-      if(notContains.find(word[idx]) != notContains.end()) {
+      if(notContains.count(word[idx])) {
         shouldRemove = true; 
         break; 
       }
-      if((correct.find(idx) != correct.end()) && !(word[idx] == correct[idx])) { 
+      if(idx < correct.size() && correct[idx] != '\0' && !(word[idx] == correct[idx])) { 
         shouldRemove = true; 
         break; 
       }
-      if((contains.find(word[idx]) != contains.end())) {
-        if (contains[word[idx]].find(idx) != contains[word[idx]].end()) {
+      if(contains.count(word[idx])) {
+        if (contains.isNotAt(word[idx], idx)) {
           shouldRemove = true; 
           break; 
         } 
@@ -729,106 +1595,2899 @@ void remainingWords(std::unordered_set<std::string> & possibleAnswers, std::unor
   std::swap(updatedPossibleAnswers, possibleAnswers);
 }
 
-/*     SolveWordle() -> returns answer to wordle game     */
-std::string SolveWordle(const Wordle& wordle) {
-  const std::string starting = "slate";  
+class PartitionCounts;
 
+/*     one game's PartitionCounts: a copied SolverState starts without any, so two games never update the same counts     */
+struct PartitionCountsSlot {
+  std::shared_ptr<PartitionCounts> counts;
+
+  PartitionCountsSlot() = default;
+  PartitionCountsSlot(const PartitionCountsSlot &) {}
+  PartitionCountsSlot(PartitionCountsSlot &&) = default;
+  PartitionCountsSlot & operator=(const PartitionCountsSlot &) { counts.reset(); return *this; }
+  PartitionCountsSlot & operator=(PartitionCountsSlot &&) = default;
+};
+
+/*     everything SolveWordle learns about the answer over one game     */
+struct SolverState {
   /*     Solution Set     */
-  std::unordered_set<std::string> possibleAnswers = GetAllValidWords(); 
+  std::unordered_set<std::string> possibleAnswers;
 
   /*     Letter State Sets     */
-  std::unordered_map<char, std::unordered_set<int>> contains; 
-  std::unordered_set<char> notContains; 
-  std::unordered_map<int, char> correct; 
+  ContainedLetters contains;
+  LetterSet notContains;
+  CorrectLetters correct{};
 
   /*     Other     */
-  std::string guess = starting; 
-  WordleLetterStates states;
-  std::unordered_set<char> guessedLetters;
+  LetterSet guessedLetters;
 
-  /*     iterating guesses     */
-  while (possibleAnswers.size() > 1) {
-    states = wordle.CharacterizeWord(guess);
+  /*     feedback bucket counts kept across rounds by the partition scoring tiers     */
+  mutable PartitionCountsSlot partitionCounts;
+};
 
-    /*     classifying characters     */
-    for (size_t idx = 0; idx < guess.size(); ++idx) {
-      guessedLetters.insert(guess[idx]);
-      if (states[idx] == CORRECT) {
-        correct[idx]= guess[idx];
-        if(notContains.find(guess[idx]) != notContains.end()) {
-          notContains.erase(guess[idx]); // remove
-        }
-        continue;
+/*     classifyLetters() -> update letter state sets from one guess     */
+void classifyLetters(SolverState & state, const std::string & guess, const WordleLetterStates & states) {
+  for (size_t idx = 0; idx < guess.size(); ++idx) {
+    state.guessedLetters.insert(guess[idx]);
+    if (states[idx] == CORRECT) {
+      state.correct[idx]= guess[idx];
+      if(state.notContains.count(guess[idx])) {
+        state.notContains.erase(guess[idx]); // remove
       }
-      if (states[idx] == CONTAINED) {
-        contains[guess[idx]].insert(idx);
-        continue;
+      continue;
+    }
+    if (states[idx] == CONTAINED) {
+      state.contains.insert(guess[idx], static_cast<int>(idx));
+      continue;
+    }
+    if (states[idx] == NOT_CONTAINED) {
+      bool isContained = false;
+      
+      /*     check if char already in "correct"     */
+      if (std::find(state.correct.begin(), state.correct.end(), guess[idx]) != state.correct.end()) {
+        isContained = true;
       }
-      if (states[idx] == NOT_CONTAINED) {
-        bool isContained = false;
-        
-        /*     check if char already in "correct"     */
-        for (const auto& pair: correct) {
-          if (pair.second == guess[idx]) {
-            isContained = true;
-            break;
-          }
-        }
-
-        /*     check if char already in "contains"     */
-        for (const auto& pair: contains) {
-          if (pair.first == guess[idx]) {
-            isContained = true;
-            break;
-          }
-        }
 
-        if (isContained) {
-          contains[guess[idx]].insert(idx);
-        } 
-        else {
-          notContains.insert(guess[idx]);
-          continue;
-        }
+      /*     check if char already in "contains"     */
+      if (state.contains.count(guess[idx])) {
+        isContained = true;
       }
-    }
 
-    /*     reduce solution set     */
-    remainingWords(possibleAnswers, contains, notContains, correct);
-  
-    /*     error catching     */
-    if (possibleAnswers.size() == 0) {
-      throw std::logic_error{"Error Encountered"};
-      std::cout << "Guess: " << guess << std::endl;
-      for (size_t idx = 0; idx < guess.size(); ++idx) {
-        std:: cout << guess[idx] << " " << states[idx] << std::endl;
-      }
-      std::cout << "Contains: " << std::endl;
-      for (auto & word: contains) {
-        std::cout << word.first << ": ";
-        for (auto & cc: word.second) {
-          std::cout << cc << ", ";
-        }
-        std::cout << std::endl;
-      }
-      std::cout << "Correct: " << std::endl;
-      for (auto & word: correct) {
-        std::cout << word.first << ": " << word.second << std::endl;
-      }
-      std::cout << "Not Contains: " << std::endl;
-      for (auto & word: notContains) {
-        std::cout << word << std::endl;
+      if (isContained) {
+        state.contains.insert(guess[idx], static_cast<int>(idx));
+      } 
+      else {
+        state.notContains.insert(guess[idx]);
+        continue;
       }
-      break;
     }
+  }
+}
 
-    guess = getNextGuess(possibleAnswers, guessedLetters);
-  } 
+/*     reduceSolutionSet() -> remainingWords() on the solver state     */
+void reduceSolutionSet(SolverState & state) {
+  remainingWords(state.possibleAnswers, state.contains, state.notContains, state.correct);
+}
 
-  std::cout << "Word: " << guess << std::endl;
+/*     failSolve() -> dump solver state for debugging, then throw     */
+[[noreturn]] void failSolve(const SolverState & state, const std::string & guess, const WordleLetterStates & states, const Alphabet & letters) {
+  std::cout << "Guess: " << decodeWord(guess, letters) << std::endl;
+  for (size_t idx = 0; idx < guess.size(); ++idx) {
+    std:: cout << decodeWord(std::string(1, guess[idx]), letters) << " " << states[idx] << std::endl;
+  }
+  std::cout << "Contains: " << std::endl;
+  for (char letter: state.contains.letters.letters()) {
+    std::cout << decodeWord(std::string(1, letter), letters) << ": ";
+    for (size_t pos = 0; pos < 5; ++pos) {
+      if (state.contains.isNotAt(letter, pos)) std::cout << pos << ", ";
+    }
+    std::cout << std::endl;
+  }
+  std::cout << "Correct: " << std::endl;
+  for (size_t pos = 0; pos < state.correct.size(); ++pos) {
+    if (state.correct[pos] != '\0') std::cout << pos << ": " << decodeWord(std::string(1, state.correct[pos]), letters) << std::endl;
+  }
+  std::cout << "Not Contains: " << std::endl;
+  for (char letter: state.notContains.letters()) {
+    std::cout << decodeWord(std::string(1, letter), letters) << std::endl;
+  }
+  throw std::logic_error{"Error Encountered"};
+}
+
+/* ======================== GUESS STRATEGIES ======================== */
+
+/*
+  getNextGuess() is cheap but picks poorly near the end of a game, while exact partition scoring is
+  O(N^2) on the full dictionary. TieredStrategy picks a scorer by the size of the solution set:
+
+    > partitionMax  -> PositionalFrequencyStrategy, O(N) letter-frequency score over candidates
+    > endgameMax    -> PartitionStrategy, exact feedback buckets of every allowed guess,
+                       minimizes expected remaining words
+    <= endgameMax   -> EndgameStrategy, exhaustive search for the fewest expected guesses
+
+  Thresholds were calibrated with the "[.benchmark]" test case below: past ~100 candidates exact
+  partition scoring costs noticeably more time without lowering the mean guess count.
+*/
+
+/*     computeFeedback() -> same result as CharacterizeWord(), without validation or allocation     */
+FeedbackCode computeFeedback(const std::string & guess, const std::string & answer) {
+  std::array<int, 5> digits{};
+  std::array<bool, 5> used{};
+
+  for (size_t idx = 0; idx < 5; ++idx) {
+    if (guess[idx] == answer[idx]) {
+      digits[idx] = 2;
+      used[idx] = true;
+    }
+  }
+
+  /*     leftmost unmatched occurrences are CONTAINED first, like letter_counts in CharacterizeWord()     */
+  for (size_t idx = 0; idx < 5; ++idx) {
+    if (digits[idx] == 2) continue;
+    for (size_t other = 0; other < 5; ++other) {
+      if (!used[other] && guess[idx] == answer[other]) {
+        digits[idx] = 1;
+        used[other] = true;
+        break;
+      }
+    }
+  }
+
+  int code = 0;
+  for (size_t idx = 5; idx-- > 0;) code = code * 3 + digits[idx];
+  return static_cast<FeedbackCode>(code);
+}
+
+/*
+  narrowByFeedback() -> classifyLetters() + reduceSolutionSet(), then keeps only the words that give exactly this
+  feedback. The letter states can't express letter counts, so a probe can split the candidates by feedback while
+  the letter filter keeps all of them; without the exact pass the solver would play that probe forever.
+*/
+void narrowByFeedback(SolverState & state, const std::string & guess, const WordleLetterStates & states) {
+  classifyLetters(state, guess, states);
+  reduceSolutionSet(state);
+  const FeedbackCode code = encodeFeedback(states);
+  std::erase_if(state.possibleAnswers, [&](const std::string & word) { return computeFeedback(guess, word) != code; });
+}
+
+/*     picks the next guess from the current solver state     */
+class GuessStrategy {
+  public:
+    GuessStrategy() : memoKey_{nextMemoKey()} {} // ctor
+    virtual ~GuessStrategy() = default;
+    virtual std::string nextGuess(const SolverState & state) const = 0;
+    uint64_t memoKey() const { return memoKey_; } // unique per strategy object and never reused, keys memoized guesses
+  private:
+    static uint64_t nextMemoKey() {
+      static std::atomic<uint64_t> next{0};
+      return next++;
+    }
+    uint64_t memoKey_;
+};
+
+/* ---------------- dictionary epoch caches ---------------- */
+
+/*     solver state after the opening guess got one feedback code, shared by epochs until a word in it changes     */
+struct OpeningBucket {
+  SolverState state;
+  mutable std::mutex mutex; // guards nextGuesses
+  mutable std::unordered_map<uint64_t, std::string> nextGuesses; // GuessStrategy::memoKey() -> its guess from "state"
+
+  std::string nextGuess(const GuessStrategy & strategy, const SolverState & game) const; // "game" is a copy of "state"
+};
+
+/*     memo entries kept per bucket before it starts over (strategies come and go in tests and sweeps)     */
+constexpr size_t kMaxMemoizedStrategies = 64;
+
+std::string OpeningBucket::nextGuess(const GuessStrategy & strategy, const SolverState & game) const {
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    auto found = nextGuesses.find(strategy.memoKey());
+    if (found != nextGuesses.end()) return found->second;
+  }
+
+  /*     outside the lock: other games in this bucket keep going     */
+  std::string guess = strategy.nextGuess(game);
+  std::lock_guard<std::mutex> lock{mutex};
+  if (nextGuesses.size() >= kMaxMemoizedStrategies) nextGuesses.clear();
+  nextGuesses.emplace(strategy.memoKey(), guess);
   return guess;
 }
 
+std::shared_ptr<const OpeningBucket> DictionaryEpoch::afterOpening(FeedbackCode code) const {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (openings_[code]) return openings_[code];
+  }
+
+  auto bucket = std::make_shared<OpeningBucket>();
+  bucket->state.possibleAnswers = words_;
+  narrowByFeedback(bucket->state, opening_, decodeFeedback(code));
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (!openings_[code]) openings_[code] = std::move(bucket);
+  return openings_[code];
+}
+
+std::shared_ptr<const DictionaryEpoch> DictionaryEpoch::next(std::unordered_set<std::string> words, Alphabet letters) const {
+  std::vector<std::string> added;
+  std::vector<std::string> removed;
+  for (const std::string & word : words) {
+    if (!contains(word)) added.push_back(word);
+  }
+  for (const std::string & word : words_) {
+    if (words.count(word) == 0) removed.push_back(word);
+  }
+
+  /*     kept words were checked against this alphabet, which still spells them the same if the new one extends it     */
+  auto next = std::make_shared<DictionaryEpoch>(std::move(words), epoch_ + 1, letters, letters.extends(letters_) ? &added : nullptr);
+
+  /*     sorted index: the old one minus removed, merged with added     */
+  std::vector<std::string> sortedAdded = added;
+  std::vector<std::string> sortedRemoved = removed;
+  std::sort(sortedAdded.begin(), sortedAdded.end());
+  std::sort(sortedRemoved.begin(), sortedRemoved.end());
+  std::call_once(next->indexOnce_, [&]() { next->index_ = std::make_shared<const WordIndex>(index().patched(sortedAdded, sortedRemoved)); });
+
+  handOnStrategy(*next, sortedAdded, sortedRemoved);
+
+  /*     a different opening guess means different buckets, the new epoch builds its own     */
+  if (next->opening_ != opening_) return next;
+  std::array<std::shared_ptr<const OpeningBucket>, kNumFeedbackCodes> openings;
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    openings = openings_;
+  }
+
+  /*     only cached openings an added or removed word lands in are copied and patched     */
+  for (size_t code = 0; code < kNumFeedbackCodes; ++code) {
+    std::shared_ptr<const OpeningBucket> & bucket = openings[code];
+    if (!bucket) continue;
+    std::vector<const std::string *> enter;
+    std::vector<const std::string *> leave;
+    for (const std::string & word : added) {
+      if (computeFeedback(opening_, word) == code) enter.push_back(&word);
+    }
+    for (const std::string & word : removed) {
+      if (bucket->state.possibleAnswers.count(word) != 0) leave.push_back(&word);
+    }
+
+    /*     shared as is: a memoized guess can be a probe outside the bucket, drop the ones that stopped being words     */
+    if (enter.empty() && leave.empty()) {
+      if (removed.empty()) continue;
+      std::lock_guard<std::mutex> lock{bucket->mutex};
+      std::erase_if(bucket->nextGuesses, [&](const auto & memo) { return !next->contains(memo.second); });
+      continue;
+    }
+
+    auto patched = std::make_shared<OpeningBucket>();
+    patched->state = bucket->state;
+    for (const std::string * word : enter) patched->state.possibleAnswers.insert(*word);
+    for (const std::string * word : leave) patched->state.possibleAnswers.erase(*word);
+    bucket = std::move(patched);
+  }
+
+  next->openings_ = std::move(openings);
+  return next;
+}
+
+/*     getNextGuess() behind the strategy interface     */
+class OverlapStrategy : public GuessStrategy {
+  public:
+    std::string nextGuess(const SolverState & state) const override {
+      return getNextGuess(state.possibleAnswers, state.guessedLetters);
+    }
+};
+
+/*     candidate sharing the most letters with the rest, by position and by presence     */
+class PositionalFrequencyStrategy : public GuessStrategy {
+  public:
+    explicit PositionalFrequencyStrategy(size_t letters = 0) : letters_{letters} {} // ctor, alphabet size; 0 = the highest code the candidates use
+    std::string nextGuess(const SolverState & state) const override;
+  private:
+    size_t letters_;
+};
+
+/*
+  positionalFrequencyPick() -> element of "words" (any range, "wordOf" gives each element's word)
+  with the best positional + presence score, ties to the smallest word, end() if "words" is empty.
+  Histograms are indexed by letter code and sized to the alphabet's "letters": they live in stack
+  buffers bounded by kMaxLetters, of which only the first 5 x letters / letters entries are
+  cleared and used, so nothing is allocated. Units that aren't letters score nothing.
+*/
+template <class Range, class WordOf>
+auto positionalFrequencyPick(const Range & words, WordOf wordOf, size_t letters) {
+  letters = std::min(letters, kMaxLetters);
+  std::array<int, 5 * kMaxLetters> positional;
+  std::array<int, kMaxLetters> presence;
+  std::fill_n(positional.begin(), 5 * letters, 0);
+  std::fill_n(presence.begin(), letters, 0);
+
+  for (const auto & element : words) {
+    const std::string & word = wordOf(element);
+    uint64_t seen = 0;
+    for (size_t idx = 0; idx < 5; ++idx) {
+      uint8_t c = letterCode(word[idx]);
+      if (c >= letters) continue;
+      positional[idx * letters + c]++;
+      if (!(seen >> c & 1)) presence[c]++;
+      seen |= uint64_t{1} << c;
+    }
+  }
+
+  long bestScore = -1;
+  auto best = std::end(words);
+  for (auto it = std::begin(words); it != std::end(words); ++it) {
+    const std::string & word = wordOf(*it);
+    long score = 0;
+    uint64_t seen = 0;
+    for (size_t idx = 0; idx < 5; ++idx) {
+      uint8_t c = letterCode(word[idx]);
+      if (c >= letters) continue;
+      score += positional[idx * letters + c];
+      if (!(seen >> c & 1)) score += presence[c]; // repeated letters only count once
+      seen |= uint64_t{1} << c;
+    }
+    if (score > bestScore || (score == bestScore && word < wordOf(*best))) {
+      bestScore = score;
+      best = it;
+    }
+  }
+
+  return best;
+}
+
+std::string PositionalFrequencyStrategy::nextGuess(const SolverState & state) const {
+  /*     a state doesn't carry its alphabet, but codes are dense: the highest one in use bounds it     */
+  size_t letters = letters_;
+  if (letters == 0) {
+    letters = kAsciiLetters;
+    for (const std::string & word : state.possibleAnswers) {
+      for (char unit : word) {
+        uint8_t c = letterCode(unit);
+        if (c < kMaxLetters) letters = std::max<size_t>(letters, c + size_t{1});
+      }
+    }
+  }
+  auto best = positionalFrequencyPick(state.possibleAnswers, [](const std::string & word) -> const std::string & { return word; }, letters);
+  return best == state.possibleAnswers.end() ? std::string{} : *best;
+}
+
+std::string pickOpening(const std::unordered_set<std::string> & words, const Alphabet & letters) {
+  if (words.count(kOpeningGuess) != 0) return kOpeningGuess;
+  SolverState state;
+  state.possibleAnswers = words;
+  return PositionalFrequencyStrategy{letters.size()}.nextGuess(state);
+}
+
+/* ---------------- packed words + partition scoring ---------------- */
+
+/*     5 letters packed 8 bits each, letter 0 in the low byte     */
+using PackedWord = uint64_t;
+
+PackedWord packWord(const std::string & word) {
+  PackedWord packed = 0;
+  for (size_t idx = 5; idx-- > 0;) packed = (packed << 8) | static_cast<unsigned char>(word[idx]);
+  return packed;
+}
+
+constexpr std::array<int, 5> kFeedbackWeights = {1, 3, 9, 27, 81};
+
+/*     computeFeedback() on packed words     */
+inline FeedbackCode packedFeedback(PackedWord guess, PackedWord answer) {
+  int code = 0;
+  uint32_t pending = 0; // guess positions that aren't CORRECT
+  PackedWord unmatched = 0; // answer letters not used yet, 0 once used
+
+  for (size_t idx = 0; idx < 5; ++idx) {
+    uint64_t g = (guess >> (8 * idx)) & 0xff;
+    uint64_t a = (answer >> (8 * idx)) & 0xff;
+    if (g == a) {
+      code += 2 * kFeedbackWeights[idx];
+    } else {
+      pending |= 1u << idx;
+      unmatched |= a << (8 * idx);
+    }
+  }
+
+  for (; pending != 0; pending &= pending - 1) {
+    size_t idx = std::countr_zero(pending);
+    uint64_t g = (guess >> (8 * idx)) & 0xff;
+    for (size_t other = 0; other < 5; ++other) {
+      if (((unmatched >> (8 * other)) & 0xff) == g) {
+        code += kFeedbackWeights[idx];
+        unmatched &= ~(PackedWord{0xff} << (8 * other));
+        break;
+      }
+    }
+  }
+
+  return static_cast<FeedbackCode>(code);
+}
+
+struct ScoredGuess {
+  uint64_t score{0}; // sum of squared bucket sizes, lower is better
+  bool candidate{false}; // could be the answer itself, wins ties
+  uint32_t guess{0}; // index into the allowed guesses
+
+  bool operator<(const ScoredGuess & other) const {
+    if (score != other.score) return score < other.score;
+    if (candidate != other.candidate) return candidate;
+    return guess < other.guess;
+  }
+};
+
+/*
+  Scores every allowed guess, not just the remaining candidates: a word that can't be the answer
+  often splits "_ight"/"_atch" style families far better than any member of the family.
+  A guess stops being scored as soon as its partial score can't make the top k (scores only grow
+  as candidates are added), and large jobs are split across threads. Ties are resolved by the full
+  ScoredGuess ordering, so the result doesn't depend on the thread count. Given a precomputed
+  allowed x allowed feedback table (SweepTables maps one), scores read it in place instead of
+  computing feedback.
+*/
+class PartitionScorer {
+  public:
+    explicit PartitionScorer(std::vector<std::string> allowedGuesses, size_t threads = std::thread::hardware_concurrency()); // ctor
+    PartitionScorer(std::vector<std::string> allowedGuesses, std::shared_ptr<const FeedbackCode> table, size_t threads = std::thread::hardware_concurrency()); // ctor, table[guess * size() + answer] by allowed id
+    std::vector<ScoredGuess> topGuesses(const std::vector<std::string> & candidates, size_t k) const; // best first
+    std::vector<ScoredGuess> topGuesses(const std::vector<std::string> & candidates, size_t k, std::chrono::steady_clock::time_point deadline, bool & expired) const; // best of the guesses scored before "deadline"
+    size_t topGuesses(std::span<const uint32_t> candidates, size_t k, ScoredGuess * top) const; // sorted allowed ids, best first into top[0, k), on this thread without allocating; returns how many
+    const std::string & word(uint32_t guess) const { return allowed_[guess]; }
+    PackedWord packed(uint32_t guess) const { return packed_[guess]; }
+    FeedbackCode feedback(uint32_t guess, uint32_t answer) const { // both allowed ids
+      return table_ ? table_.get()[size_t{guess} * packed_.size() + answer] : packedFeedback(packed_[guess], packed_[answer]);
+    }
+    size_t size() const { return allowed_.size(); }
+    size_t threads() const { return threads_; }
+    std::optional<std::vector<uint32_t>> ids(const std::vector<std::string> & words) const; // sorted, nullopt if any word isn't allowed
+    std::shared_ptr<const PartitionScorer> patched(const std::vector<std::string> & added, const std::vector<std::string> & removed) const; // sorted allowed guesses minus "removed" plus "added" (both sorted), kept words not repacked, no table
+  private:
+    PartitionScorer(std::vector<std::string> allowedGuesses, std::vector<PackedWord> packed, size_t threads); // ctor, "packed" already matches
+    void indexAllowed(); // sorted_, and ids_ if the allowed guesses aren't sorted
+    void scoreRange(size_t begin, size_t end, const std::vector<PackedWord> & candidates, const std::vector<uint32_t> * candidateIds, size_t k,
+                    std::vector<ScoredGuess> & top, std::chrono::steady_clock::time_point deadline, std::atomic<bool> & expired) const;
+
+    std::vector<std::string> allowed_;
+    std::vector<PackedWord> packed_;
+    bool sorted_{false}; // allowed_ sorted and unique: ids() is a binary search over it
+    std::unordered_map<PackedWord, uint32_t> ids_; // word -> id otherwise
+    std::shared_ptr<const FeedbackCode> table_; // null: computed with packedFeedback()
+    size_t threads_;
+};
+
+/*     below this many (guess, candidate) pairs threads cost more than they save     */
+constexpr size_t kParallelScoringPairs = size_t{1} << 18;
+
+/*     guesses scored between two looks at the clock     */
+constexpr size_t kDeadlineCheckGuesses = 32;
+
+PartitionScorer::PartitionScorer(std::vector<std::string> allowedGuesses, size_t threads)
+  : PartitionScorer{std::move(allowedGuesses), nullptr, threads} {}
+
+PartitionScorer::PartitionScorer(std::vector<std::string> allowedGuesses, std::shared_ptr<const FeedbackCode> table, size_t threads)
+  : allowed_{std::move(allowedGuesses)}, table_{std::move(table)}, threads_{std::max<size_t>(threads, 1)} {
+  packed_.reserve(allowed_.size());
+  for (const std::string & word : allowed_) packed_.push_back(packWord(word));
+  indexAllowed();
+}
+
+PartitionScorer::PartitionScorer(std::vector<std::string> allowedGuesses, std::vector<PackedWord> packed, size_t threads)
+  : allowed_{std::move(allowedGuesses)}, packed_{std::move(packed)}, threads_{threads} {
+  indexAllowed();
+}
+
+void PartitionScorer::indexAllowed() {
+  sorted_ = std::adjacent_find(allowed_.begin(), allowed_.end(), std::greater_equal<>{}) == allowed_.end();
+  if (sorted_) return;
+  for (uint32_t id = 0; id < packed_.size(); ++id) ids_.emplace(packed_[id], id);
+}
+
+std::shared_ptr<const PartitionScorer> PartitionScorer::patched(const std::vector<std::string> & added, const std::vector<std::string> & removed) const {
+  if (!sorted_) throw std::logic_error{"Only a scorer over sorted allowed guesses can be patched."};
+  std::vector<std::string> allowed;
+  std::vector<PackedWord> packed;
+  allowed.reserve(allowed_.size() + added.size());
+  packed.reserve(allowed_.size() + added.size());
+  patchSorted(allowed_, added, removed,
+              [&](size_t id) {
+                allowed.push_back(allowed_[id]);
+                packed.push_back(packed_[id]);
+              },
+              [&](const std::string & word) {
+                allowed.push_back(word);
+                packed.push_back(packWord(word));
+              });
+  return std::shared_ptr<const PartitionScorer>(new PartitionScorer(std::move(allowed), std::move(packed), threads_));
+}
+
+std::optional<std::vector<uint32_t>> PartitionScorer::ids(const std::vector<std::string> & words) const {
+  std::vector<uint32_t> found;
+  found.reserve(words.size());
+  for (const std::string & word : words) {
+    if (sorted_) {
+      auto it = std::lower_bound(allowed_.begin(), allowed_.end(), word);
+      if (it == allowed_.end() || *it != word) return std::nullopt;
+      found.push_back(static_cast<uint32_t>(it - allowed_.begin()));
+      continue;
+    }
+    auto it = ids_.find(packWord(word));
+    if (it == ids_.end()) return std::nullopt;
+    found.push_back(it->second);
+  }
+  std::sort(found.begin(), found.end());
+  found.erase(std::unique(found.begin(), found.end()), found.end());
+  return found;
+}
+
+std::vector<ScoredGuess> PartitionScorer::topGuesses(const std::vector<std::string> & candidates, size_t k) const {
+  bool expired = false;
+  return topGuesses(candidates, k, std::chrono::steady_clock::time_point::max(), expired);
+}
+
+std::vector<ScoredGuess> PartitionScorer::topGuesses(const std::vector<std::string> & candidates, size_t k, std::chrono::steady_clock::time_point deadline, bool & expired) const {
+  expired = false;
+  if (k == 0 || candidates.empty()) return {};
+
+  /*     sorted so "is this guess a candidate" is a binary search     */
+  std::vector<PackedWord> packedCandidates;
+  packedCandidates.reserve(candidates.size());
+  for (const std::string & word : candidates) packedCandidates.push_back(packWord(word));
+  std::sort(packedCandidates.begin(), packedCandidates.end());
+  std::optional<std::vector<uint32_t>> candidateIds = table_ ? ids(candidates) : std::nullopt;
+  const std::vector<uint32_t> * tableIds = candidateIds ? &*candidateIds : nullptr;
+
+  size_t numThreads = 1;
+  if (packed_.size() * packedCandidates.size() >= kParallelScoringPairs) numThreads = std::min(threads_, packed_.size());
+
+  std::vector<std::vector<ScoredGuess>> tops(numThreads);
+  std::vector<std::thread> threads;
+  std::atomic<bool> late{false};
+  size_t chunk = (packed_.size() + numThreads - 1) / numThreads;
+  for (size_t t = 0; t < numThreads; ++t) {
+    size_t begin = std::min(packed_.size(), t * chunk);
+    size_t end = std::min(packed_.size(), begin + chunk);
+    if (t + 1 == numThreads) {
+      scoreRange(begin, end, packedCandidates, tableIds, k, tops[t], deadline, late);
+    } else {
+      threads.emplace_back([&, begin, end, t]() { scoreRange(begin, end, packedCandidates, tableIds, k, tops[t], deadline, late); });
+    }
+  }
+  for (auto & thread : threads) thread.join();
+  expired = late.load();
+
+  std::vector<ScoredGuess> merged;
+  for (const auto & top : tops) merged.insert(merged.end(), top.begin(), top.end());
+  std::sort(merged.begin(), merged.end());
+  if (merged.size() > k) merged.resize(k);
+  return merged;
+}
+
+size_t PartitionScorer::topGuesses(std::span<const uint32_t> candidates, size_t k, ScoredGuess * top) const {
+  if (k == 0 || candidates.empty()) return 0;
+  size_t found = 0;
+  uint64_t cutoff = std::numeric_limits<uint64_t>::max();
+
+  for (uint32_t g = 0; g < packed_.size(); ++g) {
+    std::array<uint32_t, kNumFeedbackCodes> buckets{};
+    uint64_t score = 0;
+    for (size_t idx = 0; idx < candidates.size() && score <= cutoff; ++idx) score += 2 * uint64_t(buckets[feedback(g, candidates[idx])]++) + 1;
+    if (score > cutoff) continue;
+
+    ScoredGuess scored{score, std::binary_search(candidates.begin(), candidates.end(), g), g};
+    size_t pos = static_cast<size_t>(std::upper_bound(top, top + found, scored) - top);
+    if (pos == k) continue;
+    if (found < k) found++;
+    std::move_backward(top + pos, top + found - 1, top + found);
+    top[pos] = scored;
+    if (found == k) cutoff = top[k - 1].score;
+  }
+  return found;
+}
+
+/*     sum of squared bucket sizes of "guess" over "candidates", or anything above cutoff once it's exceeded     */
+uint64_t partitionScore(PackedWord guess, const std::vector<PackedWord> & candidates, uint64_t cutoff = std::numeric_limits<uint64_t>::max()) {
+  std::array<uint32_t, kNumFeedbackCodes> buckets{};
+  uint64_t score = 0;
+
+  /*     (c + 1)^2 - c^2 = 2c + 1     */
+  for (PackedWord answer : candidates) {
+    uint32_t count = buckets[packedFeedback(guess, answer)]++;
+    score += 2 * uint64_t(count) + 1;
+    if (score > cutoff) break;
+  }
+  return score;
+}
+
+/*     same, reading one guess's row of a feedback table     */
+uint64_t partitionScore(const FeedbackCode * row, const std::vector<uint32_t> & candidates, uint64_t cutoff = std::numeric_limits<uint64_t>::max()) {
+  std::array<uint32_t, kNumFeedbackCodes> buckets{};
+  uint64_t score = 0;
+  for (uint32_t answer : candidates) {
+    uint32_t count = buckets[row[answer]]++;
+    score += 2 * uint64_t(count) + 1;
+    if (score > cutoff) break;
+  }
+  return score;
+}
+
+void PartitionScorer::scoreRange(size_t begin, size_t end, const std::vector<PackedWord> & candidates, const std::vector<uint32_t> * candidateIds, size_t k,
+                                 std::vector<ScoredGuess> & top, std::chrono::steady_clock::time_point deadline, std::atomic<bool> & expired) const {
+  uint64_t cutoff = std::numeric_limits<uint64_t>::max(); // k-th best score so far
+  const bool timed = deadline != std::chrono::steady_clock::time_point::max();
+
+  for (size_t g = begin; g < end; ++g) {
+    if (timed && (g - begin) % kDeadlineCheckGuesses == 0) {
+      if (expired.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= deadline) {
+        expired = true;
+        break;
+      }
+    }
+    uint64_t score = candidateIds != nullptr ? partitionScore(table_.get() + g * packed_.size(), *candidateIds, cutoff) : partitionScore(packed_[g], candidates, cutoff);
+    if (score > cutoff) continue;
+
+    ScoredGuess scored{score, std::binary_search(candidates.begin(), candidates.end(), packed_[g]), static_cast<uint32_t>(g)};
+    top.insert(std::upper_bound(top.begin(), top.end(), scored), scored);
+    if (top.size() > k) top.pop_back();
+    if (top.size() == k) cutoff = top.back().score;
+  }
+}
+
+/*
+  PartitionScorer recomputes every guess's buckets from scratch each round. PartitionCounts keeps
+  them alive for one game instead: when the solution set shrinks by at most 1/kSubtractShare of
+  what stays, each eliminated candidate is subtracted from every guess's buckets, which is
+  (guesses x eliminated) work. A bigger shrink leaves the counts stale rather than recounting
+  the survivors: rankGuesses() then rescans with the scorer, which keeps its early cut-off and is
+  cheaper than any recount. Stale counts are only rebuilt after a slow shrink, which predicts
+  more of them, so in normal play (sets shrinking 10-20x per round) the counts are never built at
+  all. The top k come out of a bounded heap over the scores (O(G log k), no G-sized copy), and
+  every retain() is logged so search code can checkpoint() and rollback() cheaply. A retain()
+  that adds words can't be undone: it invalidates every earlier checkpoint, and rolling back to
+  one throws.
+
+  The counts take guesses x 243 x 2 bytes per game (about 2 MB at 4k allowed guesses), allocated
+  on first use. All live instances share kPartitionCountsBudget: create() gives nullptr once it's
+  spent, and the caller rescans instead, so thousands of pipelined games can't turn the flag into
+  gigabytes.
+*/
+constexpr size_t kPartitionCountsBudget = size_t{256} << 20;
+
+/*     subtract when at most survivors / kSubtractShare words left; beyond that a cut-off rescan is cheaper ("[benchmark]")     */
+constexpr size_t kSubtractShare = 4;
+
+class PartitionCounts {
+  public:
+    PartitionCounts(std::shared_ptr<const PartitionScorer> scorer, std::vector<uint32_t> candidates); // ctor, candidates are sorted allowed ids; counted on first topGuesses()
+    ~PartitionCounts(); // dtor, returns its bytes to the budget
+    PartitionCounts(const PartitionCounts &) = delete;
+    PartitionCounts & operator=(const PartitionCounts &) = delete;
+    static std::shared_ptr<PartitionCounts> create(std::shared_ptr<const PartitionScorer> scorer, std::vector<uint32_t> candidates); // nullptr if over budget
+    static size_t bytesInUse() { return liveBytes().load(); } // all live instances
+    void retain(const std::vector<uint32_t> & survivors); // sorted ids, normally a subset of candidates()
+    size_t checkpoint() const { return undoBase_ + undo_.size(); }
+    void rollback(size_t mark); // undo every retain() since checkpoint "mark", throws if "mark" is no longer (or not yet) reachable
+    std::vector<ScoredGuess> topGuesses(size_t k); // best first, rebuilds stale counts
+    bool stale() const { return stale_; } // counts don't match candidates(), topGuesses() would rebuild them
+    bool shrinkingSlowly() const { return shrinkingSlowly_; } // the last retain() could subtract, so rebuilding is likely to pay off
+    const std::vector<uint32_t> & candidates() const { return candidates_; }
+    const PartitionScorer * scorer() const { return scorer_.get(); }
+    size_t subtractions() const { return subtractions_; } // incremental updates so far
+    size_t rebuilds() const { return rebuilds_; } // counts built from the candidates so far
+  private:
+    void update(const std::vector<uint32_t> & answers, bool add); // every guess's buckets +/- each answer
+    void rebuild();
+    static size_t bytesFor(const PartitionScorer & scorer) { return scorer.size() * kNumFeedbackCodes * sizeof(uint16_t); }
+    static std::atomic<size_t> & liveBytes() {
+      static std::atomic<size_t> bytes{0};
+      return bytes;
+    }
+
+    std::shared_ptr<const PartitionScorer> scorer_;
+    std::vector<uint16_t> counts_; // guess * kNumFeedbackCodes + feedback
+    std::vector<uint64_t> scores_; // sum of squared bucket sizes per guess
+    std::vector<uint32_t> candidates_; // alive, sorted
+    std::vector<bool> alive_; // by allowed id
+    bool stale_{true};
+    bool shrinkingSlowly_{false};
+    std::vector<std::vector<uint32_t>> undo_; // words removed by each retain()
+    size_t undoBase_{0}; // checkpoint of undo_.front(); everything before it was dropped by a retain() that added words
+    size_t subtractions_{0};
+    size_t rebuilds_{0};
+};
+
+PartitionCounts::PartitionCounts(std::shared_ptr<const PartitionScorer> scorer, std::vector<uint32_t> candidates)
+  : scorer_{std::move(scorer)}, candidates_{std::move(candidates)} {
+  if (candidates_.size() > std::numeric_limits<uint16_t>::max()) throw std::logic_error{"Too many candidates for PartitionCounts."};
+  alive_.assign(scorer_->size(), false);
+  for (uint32_t id : candidates_) alive_[id] = true;
+  liveBytes() += bytesFor(*scorer_);
+}
+
+PartitionCounts::~PartitionCounts() {
+  liveBytes() -= bytesFor(*scorer_);
+}
+
+std::shared_ptr<PartitionCounts> PartitionCounts::create(std::shared_ptr<const PartitionScorer> scorer, std::vector<uint32_t> candidates) {
+  /*     checked before allocating; games racing past the check can overshoot by one instance each     */
+  if (liveBytes().load() + bytesFor(*scorer) > kPartitionCountsBudget) return nullptr;
+  return std::make_shared<PartitionCounts>(std::move(scorer), std::move(candidates));
+}
+
+void PartitionCounts::update(const std::vector<uint32_t> & answers, bool add) {
+  if (answers.empty()) return;
+
+  /*     guesses are independent, split them across threads for big updates     */
+  const size_t guesses = scorer_->size();
+  size_t chunks = guesses * answers.size() >= kParallelScoringPairs ? scorer_->threads() : 1;
+  size_t chunkSize = (guesses + chunks - 1) / chunks;
+  parallelFor(chunks, chunks, [&](size_t chunk) {
+    for (size_t g = chunk * chunkSize; g < std::min(guesses, (chunk + 1) * chunkSize); ++g) {
+      uint16_t * buckets = &counts_[g * kNumFeedbackCodes];
+      for (uint32_t answer : answers) {
+        uint16_t & count = buckets[scorer_->feedback(static_cast<uint32_t>(g), answer)];
+        if (add) {
+          scores_[g] += 2 * uint64_t(count) + 1; // (c + 1)^2 - c^2
+          count++;
+        } else {
+          scores_[g] -= 2 * uint64_t(count) - 1; // c^2 - (c - 1)^2
+          count--;
+        }
+      }
+    }
+  });
+}
+
+void PartitionCounts::rebuild() {
+  counts_.assign(scorer_->size() * kNumFeedbackCodes, 0);
+  scores_.assign(scorer_->size(), 0);
+  update(candidates_, true);
+  stale_ = false;
+  rebuilds_++;
+}
+
+void PartitionCounts::retain(const std::vector<uint32_t> & survivors) {
+  std::vector<uint32_t> removed;
+  std::set_difference(candidates_.begin(), candidates_.end(), survivors.begin(), survivors.end(), std::back_inserter(removed));
+  bool subset = std::includes(candidates_.begin(), candidates_.end(), survivors.begin(), survivors.end());
+
+  for (uint32_t id : removed) alive_[id] = false;
+  for (uint32_t id : survivors) alive_[id] = true;
+  candidates_ = survivors;
+
+  /*     subtract a small shrink; anything bigger is left to a cut-off rescan, the counts go stale     */
+  shrinkingSlowly_ = subset && removed.size() * kSubtractShare <= survivors.size();
+  if (shrinkingSlowly_ && !stale_) {
+    update(removed, false);
+    subtractions_++;
+  } else {
+    stale_ = true;
+  }
+
+  /*     words that appeared from nowhere can't be rolled back to, start over past every earlier checkpoint     */
+  if (!subset) {
+    undoBase_ += undo_.size() + 1;
+    undo_.clear();
+  } else {
+    undo_.push_back(std::move(removed));
+  }
+}
+
+void PartitionCounts::rollback(size_t mark) {
+  if (mark < undoBase_ || mark > checkpoint()) throw std::logic_error{"PartitionCounts checkpoint " + std::to_string(mark) + " can't be rolled back to."};
+  std::vector<uint32_t> restored;
+  while (checkpoint() > mark) {
+    restored.insert(restored.end(), undo_.back().begin(), undo_.back().end());
+    undo_.pop_back();
+  }
+  if (restored.empty()) return;
+
+  std::sort(restored.begin(), restored.end());
+  for (uint32_t id : restored) alive_[id] = true;
+  std::vector<uint32_t> merged;
+  std::merge(candidates_.begin(), candidates_.end(), restored.begin(), restored.end(), std::back_inserter(merged));
+  candidates_ = std::move(merged);
+
+  /*     adding back is never more work than a rebuild; stale counts stay stale     */
+  if (stale_) return;
+  update(restored, true);
+  subtractions_++;
+}
+
+std::vector<ScoredGuess> PartitionCounts::topGuesses(size_t k) {
+  if (stale_) rebuild();
+
+  /*     max-heap of the best k so far, its front is the one to beat     */
+  std::vector<ScoredGuess> top;
+  top.reserve(k + 1);
+  for (uint32_t g = 0; g < scores_.size() && k > 0; ++g) {
+    ScoredGuess scored{scores_[g], alive_[g], g};
+    if (top.size() == k && !(scored < top.front())) continue;
+    top.push_back(scored);
+    std::push_heap(top.begin(), top.end());
+    if (top.size() > k) {
+      std::pop_heap(top.begin(), top.end());
+      top.pop_back();
+    }
+  }
+  std::sort_heap(top.begin(), top.end());
+  return top;
+}
+
+/*
+  rankGuesses() -> top k guesses for the sorted "words", through the game's PartitionCounts if
+  "incremental". The counts answer only while the set shrinks slowly; after a big shrink (the
+  usual case) this is the same cut-off rescan as the non-incremental path, so turning it on
+  never costs more than the set differences. Off by default for the memory. Games that find
+  kPartitionCountsBudget spent rescan like the non-incremental path.
+*/
+std::vector<ScoredGuess> rankGuesses(const SolverState & state, const std::vector<std::string> & words, const std::shared_ptr<const PartitionScorer> & scorer, size_t k, bool incremental) {
+  if (!incremental) return scorer->topGuesses(words, k);
+  std::optional<std::vector<uint32_t>> ids = scorer->ids(words);
+  if (!ids || ids->size() > std::numeric_limits<uint16_t>::max()) return scorer->topGuesses(words, k);
+
+  std::shared_ptr<PartitionCounts> & counts = state.partitionCounts.counts;
+  if (!counts || counts->scorer() != scorer.get()) {
+    counts = PartitionCounts::create(scorer, std::move(*ids));
+    if (!counts) return scorer->topGuesses(words, k);
+  } else if (counts->candidates() != *ids) {
+    counts->retain(*ids);
+  }
+  if (counts->stale() && !counts->shrinkingSlowly()) return scorer->topGuesses(words, k);
+  return counts->topGuesses(k);
+}
+
+/*     allowed guess minimizing the sum of squared feedback bucket sizes (= expected remaining words * N)     */
+class PartitionStrategy : public GuessStrategy {
+  public:
+    explicit PartitionStrategy(std::shared_ptr<const PartitionScorer> scorer, bool incremental = false)
+      : scorer_{std::move(scorer)}, incremental_{incremental} {}
+    std::string nextGuess(const SolverState & state) const override;
+  private:
+    std::shared_ptr<const PartitionScorer> scorer_;
+    bool incremental_; // keep PartitionCounts across rounds
+};
+
+std::string PartitionStrategy::nextGuess(const SolverState & state) const {
+  std::vector<std::string> words(state.possibleAnswers.begin(), state.possibleAnswers.end());
+  std::sort(words.begin(), words.end());
+  if (words.empty()) return {};
+
+  std::vector<ScoredGuess> best = rankGuesses(state, words, scorer_, 1, incremental_);
+  return best.empty() ? words.front() : scorer_->word(best.front().guess);
+}
+
+/* ---------------- scoring policies ---------------- */
+
+/*
+  Objectives for the next guess. A policy turns one guess's feedback buckets into a score (lower is
+  better) in a static reduce(); PolicyStrategy<Policy> stamps out the scoring loop per policy so
+  reduce() inlines into it, and the only runtime dispatch left is one virtual nextGuess() per move,
+  chosen once by makePolicyStrategy(). Policies that don't look at buckets set kNeedsBuckets false.
+*/
+enum ScoringPolicy : uint32_t {
+  EXPECTED_SIZE_POLICY = 0,
+  ENTROPY_POLICY = 1,
+  MINIMAX_POLICY = 2,
+  OVERLAP_POLICY = 3
+};
+
+using FeedbackBuckets = std::array<uint32_t, kNumFeedbackCodes>;
+
+/*     sum of squared bucket sizes (= expected remaining words * N)     */
+struct ExpectedSizePolicy {
+  static constexpr bool kNeedsBuckets = true;
+  using Score = uint64_t;
+  static Score reduce(const FeedbackBuckets & buckets) {
+    uint64_t score = 0;
+    for (uint64_t count : buckets) score += count * count;
+    return score;
+  }
+};
+
+/*     sum of c * log2(c): the entropy of the feedback is log2(N) - (this) / N     */
+struct EntropyPolicy {
+  static constexpr bool kNeedsBuckets = true;
+  using Score = double;
+  static Score reduce(const FeedbackBuckets & buckets) {
+    double score = 0.0;
+    for (uint32_t count : buckets) {
+      if (count > 1) score += count * std::log2(double(count));
+    }
+    return score;
+  }
+};
+
+/*     largest bucket, expected size on ties     */
+struct MinimaxPolicy {
+  static constexpr bool kNeedsBuckets = true;
+  using Score = std::pair<uint32_t, uint64_t>;
+  static Score reduce(const FeedbackBuckets & buckets) {
+    return {*std::max_element(buckets.begin(), buckets.end()), ExpectedSizePolicy::reduce(buckets)};
+  }
+};
+
+/*     getNextGuess(): the candidate sharing the fewest letters with earlier guesses, ties to the smallest word (not hash order)     */
+struct OverlapPolicy {
+  static constexpr bool kNeedsBuckets = false;
+};
+
+/*     a guess's score under Policy, ordered like ScoredGuess (candidate first, then lowest id)     */
+template <class Policy>
+struct PolicyScored {
+  typename Policy::Score score;
+  bool candidate;
+  uint32_t guess;
+
+  bool operator<(const PolicyScored & other) const {
+    if (score != other.score) return score < other.score;
+    if (candidate != other.candidate) return candidate;
+    return guess < other.guess;
+  }
+};
+
+/*     bestByPolicy() -> best of the allowed guesses [begin, end) over the sorted candidate ids, nullopt for an empty range; no allocation     */
+template <class Policy>
+std::optional<PolicyScored<Policy>> bestByPolicy(const PartitionScorer & scorer, std::span<const uint32_t> candidates, size_t begin, size_t end) {
+  std::optional<PolicyScored<Policy>> best;
+  FeedbackBuckets buckets;
+  for (size_t g = begin; g < end; ++g) {
+    const uint32_t guess = static_cast<uint32_t>(g);
+    buckets.fill(0);
+    for (uint32_t answer : candidates) buckets[scorer.feedback(guess, answer)]++;
+
+    PolicyScored<Policy> scored{Policy::reduce(buckets), std::binary_search(candidates.begin(), candidates.end(), guess), guess};
+    if (!best || scored < *best) best = scored;
+  }
+  return best;
+}
+
+/*     best allowed guess under Policy, ties like ScoredGuess (candidate first, then lowest id)     */
+template <class Policy>
+class PolicyStrategy : public GuessStrategy {
+  public:
+    explicit PolicyStrategy(std::shared_ptr<const PartitionScorer> scorer) : scorer_{std::move(scorer)} {}
+    std::string nextGuess(const SolverState & state) const override;
+  private:
+    std::shared_ptr<const PartitionScorer> scorer_;
+};
+
+template <class Policy>
+std::string PolicyStrategy<Policy>::nextGuess(const SolverState & state) const {
+  if constexpr (!Policy::kNeedsBuckets) {
+    const std::string * best = nullptr;
+    int bestOverlap = std::numeric_limits<int>::max();
+    for (const std::string & word : state.possibleAnswers) {
+      int overlap = calculateLetterOverlap(word, state.guessedLetters);
+      if (overlap < bestOverlap || (overlap == bestOverlap && word < *best)) {
+        bestOverlap = overlap;
+        best = &word;
+      }
+    }
+    return best ? *best : std::string{};
+  } else {
+    if (state.possibleAnswers.empty()) return {};
+    std::vector<std::string> words(state.possibleAnswers.begin(), state.possibleAnswers.end());
+    std::optional<std::vector<uint32_t>> ids = scorer_->ids(words);
+
+    /*     candidates that aren't allowed guesses have no id: score them on their packed words     */
+    std::vector<PackedWord> packed;
+    if (!ids) {
+      for (const std::string & word : words) packed.push_back(packWord(word));
+      std::sort(packed.begin(), packed.end());
+    }
+
+    const size_t numGuesses = scorer_->size();
+    size_t chunks = 1;
+    if (numGuesses * words.size() >= kParallelScoringPairs) chunks = std::min(scorer_->threads(), numGuesses);
+    const size_t chunkSize = (numGuesses + chunks - 1) / chunks;
+
+    std::vector<std::optional<PolicyScored<Policy>>> bests(chunks);
+    parallelFor(chunks, chunks, [&](size_t chunk) {
+      const size_t begin = chunk * chunkSize;
+      const size_t end = std::min(numGuesses, (chunk + 1) * chunkSize);
+      if (ids) {
+        bests[chunk] = bestByPolicy<Policy>(*scorer_, *ids, begin, end);
+        return;
+      }
+      FeedbackBuckets buckets;
+      for (size_t g = begin; g < end; ++g) {
+        const PackedWord guess = scorer_->packed(static_cast<uint32_t>(g));
+        buckets.fill(0);
+        for (PackedWord answer : packed) buckets[packedFeedback(guess, answer)]++;
+
+        PolicyScored<Policy> scored{Policy::reduce(buckets), std::binary_search(packed.begin(), packed.end(), guess), static_cast<uint32_t>(g)};
+        if (!bests[chunk] || scored < *bests[chunk]) bests[chunk] = scored;
+      }
+    });
+
+    std::optional<PolicyScored<Policy>> best;
+    for (const auto & chunkBest : bests) {
+      if (chunkBest && (!best || *chunkBest < *best)) best = chunkBest;
+    }
+
+    /*     no allowed guesses at all: a candidate, like PartitionStrategy     */
+    return best ? scorer_->word(best->guess) : *std::min_element(words.begin(), words.end());
+  }
+}
+
+/*     the runtime switch over the policy instantiations; expected size keeps the cut-off scorer     */
+std::unique_ptr<GuessStrategy> makePolicyStrategy(ScoringPolicy policy, std::shared_ptr<const PartitionScorer> scorer, bool incremental = false) {
+  switch (policy) {
+    case EXPECTED_SIZE_POLICY: return std::make_unique<PartitionStrategy>(std::move(scorer), incremental);
+    case ENTROPY_POLICY: return std::make_unique<PolicyStrategy<EntropyPolicy>>(std::move(scorer));
+    case MINIMAX_POLICY: return std::make_unique<PolicyStrategy<MinimaxPolicy>>(std::move(scorer));
+    case OVERLAP_POLICY: return std::make_unique<PolicyStrategy<OverlapPolicy>>(std::move(scorer));
+  }
+  throw std::logic_error{"Unknown scoring policy " + std::to_string(policy)};
+}
+
+struct AnytimeBudget {
+  size_t maxPairs{size_t{1} << 21}; // (guess, candidate) feedback evaluations per move, the reproducible limit, never exceeded
+  std::chrono::microseconds deadline{50000}; // wall-clock cap per move, checked every kDeadlineCheckGuesses guesses, wins over maxPairs
+  size_t sampleSize{256}; // candidates scored in the first, sampled pass, at most maxPairs / allowed guesses
+  size_t refineTop{64}; // best sampled guesses rescored exactly
+  uint32_t seed{0};
+};
+
+/*     what the last decision cost, for benchmarks     */
+struct AnytimeReport {
+  bool exact{false}; // whole set fit in the budget and was scored in time, same guess as PartitionStrategy
+  size_t sampled{0}; // candidates in the sample
+  size_t refined{0}; // guesses rescored on the full set
+  size_t pairs{0}; // feedback evaluations spent
+  bool deadlineHit{false}; // stopped by the clock, not the budget -> may not reproduce
+  uint64_t score{0}; // exact score of the chosen guess when refined, else its sampled score
+};
+
+/*
+  Partition scoring under a per-move budget. Sets that fit are scored exactly. Otherwise every
+  allowed guess is scored on a stratified sample (proportional per first letter, at least one
+  word from each while the sample allows), sized so this pass stays within maxPairs, and the best
+  sampled guesses are then rescored on the full set, best first, while the work budget and the
+  deadline last; the best exactly scored guess wins, else the best sampled one. Every pass looks
+  at the clock, so a move overruns the deadline by at most kDeadlineCheckGuesses guesses' worth of
+  scoring. A budget too small to score even one candidate against every allowed guess returns the
+  first candidate. The sample is drawn from an mt19937 seeded with (seed, set size), so a fixed
+  seed and maxPairs give the same guess on every run unless the deadline cuts in first.
+*/
+class AnytimeStrategy : public GuessStrategy {
+  public:
+    AnytimeStrategy(std::shared_ptr<const PartitionScorer> scorer, AnytimeBudget budget = {}) // ctor
+      : scorer_{std::move(scorer)}, budget_{budget} {}
+    std::string nextGuess(const SolverState & state) const override;
+    std::string choose(const std::vector<std::string> & words, AnytimeReport * report = nullptr) const; // words sorted
+  private:
+    std::vector<std::string> stratifiedSample(const std::vector<std::string> & words, size_t size) const;
+
+    std::shared_ptr<const PartitionScorer> scorer_;
+    AnytimeBudget budget_;
+};
+
+std::string AnytimeStrategy::nextGuess(const SolverState & state) const {
+  std::vector<std::string> words(state.possibleAnswers.begin(), state.possibleAnswers.end());
+  std::sort(words.begin(), words.end());
+  return choose(words);
+}
+
+std::vector<std::string> AnytimeStrategy::stratifiedSample(const std::vector<std::string> & words, size_t size) const {
+  std::mt19937 rng(budget_.seed ^ static_cast<uint32_t>(words.size() * 2654435761u));
+
+  /*     strata: runs of the same first letter in the sorted list     */
+  std::vector<std::pair<size_t, size_t>> strata;
+  for (size_t begin = 0; begin < words.size();) {
+    size_t end = begin;
+    while (end < words.size() && words[end][0] == words[begin][0]) ++end;
+    strata.emplace_back(begin, end);
+    begin = end;
+  }
+
+  /*     proportional shares, then what rounding left over: empty strata first, then in order     */
+  size = std::min(size, words.size());
+  std::vector<size_t> takes;
+  size_t taken = 0;
+  for (const auto & [begin, end] : strata) {
+    takes.push_back((end - begin) * size / words.size());
+    taken += takes.back();
+  }
+  for (bool emptyOnly : {true, false}) {
+    for (size_t idx = 0; idx < strata.size() && taken < size; ++idx) {
+      if ((emptyOnly && takes[idx] != 0) || takes[idx] == strata[idx].second - strata[idx].first) continue;
+      takes[idx]++;
+      taken++;
+    }
+  }
+
+  std::vector<std::string> sample;
+  for (size_t stratum = 0; stratum < strata.size(); ++stratum) {
+    const auto & [begin, end] = strata[stratum];
+    size_t count = end - begin;
+
+    /*     partial Fisher-Yates on indices, rng() % n so the draw doesn't depend on the standard library     */
+    std::vector<size_t> order(count);
+    for (size_t idx = 0; idx < count; ++idx) order[idx] = begin + idx;
+    for (size_t idx = 0; idx < takes[stratum]; ++idx) {
+      std::swap(order[idx], order[idx + rng() % (count - idx)]);
+      sample.push_back(words[order[idx]]);
+    }
+  }
+  std::sort(sample.begin(), sample.end());
+  return sample;
+}
+
+std::string AnytimeStrategy::choose(const std::vector<std::string> & words, AnytimeReport * report) const {
+  AnytimeReport local;
+  AnytimeReport & stats = report != nullptr ? *report : local;
+  stats = AnytimeReport{};
+  if (words.empty()) return {};
+  auto start = std::chrono::steady_clock::now();
+  const auto deadline = start + budget_.deadline;
+
+  if (words.size() * scorer_->size() <= budget_.maxPairs) {
+    std::vector<ScoredGuess> best = scorer_->topGuesses(words, 1, deadline, stats.deadlineHit);
+    stats.exact = !stats.deadlineHit;
+    stats.pairs = words.size() * scorer_->size(); // upper bound when the deadline cut in
+    stats.score = best.empty() ? 0 : best.front().score;
+    return best.empty() ? words.front() : scorer_->word(best.front().guess);
+  }
+
+  /*     pass 1: every allowed guess on a sample small enough for the budget     */
+  size_t sampleSize = std::min(budget_.sampleSize, budget_.maxPairs / std::max<size_t>(scorer_->size(), 1));
+  if (sampleSize == 0) return words.front();
+  std::vector<std::string> sample = stratifiedSample(words, sampleSize);
+  std::vector<ScoredGuess> shortlist = scorer_->topGuesses(sample, budget_.refineTop, deadline, stats.deadlineHit);
+  stats.sampled = sample.size();
+  stats.pairs = sample.size() * scorer_->size();
+  if (shortlist.empty()) return words.front();
+  ScoredGuess best = shortlist.front();
+  stats.score = best.score;
+
+  /*     pass 2: exact scores, most promising first, while budget and time last     */
+  std::vector<PackedWord> packed;
+  packed.reserve(words.size());
+  for (const std::string & word : words) packed.push_back(packWord(word));
+  std::sort(packed.begin(), packed.end());
+
+  bool refinedAny = false;
+  for (const ScoredGuess & sampled : shortlist) {
+    if (stats.deadlineHit || stats.pairs + packed.size() > budget_.maxPairs) break;
+    if (std::chrono::steady_clock::now() >= deadline) {
+      stats.deadlineHit = true;
+      break;
+    }
+
+    uint64_t cutoff = refinedAny ? best.score : std::numeric_limits<uint64_t>::max();
+    uint64_t score = partitionScore(scorer_->packed(sampled.guess), packed, cutoff);
+    stats.pairs += packed.size();
+    stats.refined++;
+
+    bool candidate = std::binary_search(packed.begin(), packed.end(), scorer_->packed(sampled.guess));
+    ScoredGuess exact{score, candidate, sampled.guess};
+    if (score <= cutoff && (!refinedAny || exact < best)) best = exact;
+    refinedAny = true;
+  }
+  stats.score = best.score;
+  return scorer_->word(best.guess);
+}
+
+/*     feedback[g][a] of guess g against word a: rows [0, n) are the n words themselves, the rest probes     */
+using EndgameRow = std::array<FeedbackCode, 32>;
+
+/*
+  endgameSearch()'s memo: subset mask -> (total guesses, best guess index), direct-mapped into a
+  fixed table so the C ABI can keep it in a game buffer. Entries are exact, so a slot lost to
+  another subset only costs searching that subset again.
+*/
+struct EndgameMemo {
+  static constexpr size_t kSlotBits = 12;
+  struct Slot {
+    uint32_t mask; // 0 = empty
+    uint16_t total;
+    uint8_t best;
+  };
+  std::array<Slot, size_t{1} << kSlotBits> slots;
+
+  Slot & slot(uint32_t mask) { return slots[(mask * 2654435761u) >> (32 - kSlotBits)]; }
+};
+
+/*
+  endgameSearch() -> (total guesses needed to solve every one of the n words, best first guess row).
+  Deeper guesses are drawn from the words (at most 32); the first guess may also be a probe row.
+  Allocates nothing: buckets live on the stack and subsets in "memo", which it clears first.
+*/
+std::pair<size_t, size_t> endgameSearch(std::span<const EndgameRow> feedback, size_t n, EndgameMemo & memo) {
+  if (n == 0) return {0, 0};
+  if (n > 32) throw std::logic_error{"Endgame search is limited to 32 words."};
+  const size_t rows = feedback.size();
+  for (EndgameMemo::Slot & slot : memo.slots) slot.mask = 0;
+
+  /*     split "others" by the feedback of guess g: at most 32 buckets     */
+  struct Buckets {
+    std::array<std::pair<FeedbackCode, uint32_t>, 32> items;
+    size_t size = 0;
+    auto begin() const { return items.begin(); }
+    auto end() const { return items.begin() + size; }
+  };
+  auto partition = [&](size_t g, uint32_t others) {
+    Buckets buckets;
+    for (; others != 0; others &= others - 1) {
+      size_t a = std::countr_zero(others);
+      auto it = std::find_if(buckets.items.begin(), buckets.items.begin() + buckets.size, [&](const auto & b) { return b.first == feedback[g][a]; });
+      if (it == buckets.items.begin() + buckets.size) buckets.items[buckets.size++] = {feedback[g][a], 1u << a};
+      else it->second |= 1u << a;
+    }
+    return buckets;
+  };
+
+  auto solve = [&](auto & self, uint32_t mask) -> std::pair<size_t, size_t> {
+    size_t count = std::popcount(mask);
+    if (count == 1) return {1, static_cast<size_t>(std::countr_zero(mask))};
+    const EndgameMemo::Slot & found = memo.slot(mask);
+    if (found.mask == mask) return {found.total, found.best};
+
+    std::pair<size_t, size_t> best{std::numeric_limits<size_t>::max(), 0};
+    for (uint32_t rest = mask; rest != 0; rest &= rest - 1) {
+      size_t g = std::countr_zero(rest);
+
+      /*     every word pays for this guess, the rest for their bucket     */
+      size_t total = count;
+      for (const auto & bucket : partition(g, mask & ~(1u << g))) {
+        total += self(self, bucket.second).first;
+        if (total >= best.first) break;
+      }
+      if (total < best.first) best = {total, g};
+
+      /*     every other word solved on the next guess -> can't do better     */
+      if (best.first == 2 * count - 1) break;
+    }
+
+    /*     at most 32 * 33 / 2 guesses in total, so it fits     */
+    memo.slot(mask) = {mask, static_cast<uint16_t>(best.first), static_cast<uint8_t>(best.second)};
+    return best;
+  };
+
+  uint32_t all = n == 32 ? 0xffffffffu : (1u << n) - 1;
+  auto result = solve(solve, all);
+
+  /*     a probe solves nobody itself, so it needs every word solved on the following guess to tie     */
+  for (size_t g = n; g < rows && result.first > 2 * n; ++g) {
+    size_t total = n;
+    for (const auto & bucket : partition(g, all)) {
+      total += solve(solve, bucket.second).first;
+      if (total >= result.first) break;
+    }
+    if (total < result.first) result = {total, g};
+  }
+  return result;
+}
+
+/*
+  Total guesses needed to solve every word in "words", best first guess in "bestGuess".
+  Deeper guesses are drawn from "words" (at most 32); the first guess may also be one of "probes".
+*/
+size_t endgameTotalGuesses(const std::vector<std::string> & words, std::string * bestGuess, const std::vector<std::string> & probes = {}) {
+  const size_t n = words.size();
+  if (n == 0) return 0;
+  if (n > 32) throw std::logic_error{"Endgame search is limited to 32 words."};
+
+  std::vector<EndgameRow> feedback(n + probes.size());
+  for (size_t g = 0; g < n + probes.size(); ++g) {
+    const std::string & guess = g < n ? words[g] : probes[g - n];
+    for (size_t a = 0; a < n; ++a) feedback[g][a] = computeFeedback(guess, words[a]);
+  }
+
+  auto memo = std::make_unique<EndgameMemo>();
+  auto result = endgameSearch(feedback, n, *memo);
+  if (bestGuess != nullptr) *bestGuess = result.second < n ? words[result.second] : probes[result.second - n];
+  return result.first;
+}
+
+/*     exhaustive search over candidate guesses (at most 32 words), plus the best partitioning probes as first guess     */
+class EndgameStrategy : public GuessStrategy {
+  public:
+    explicit EndgameStrategy(std::shared_ptr<const PartitionScorer> scorer = nullptr, size_t probes = 16, bool incremental = false)
+      : scorer_{std::move(scorer)}, probes_{probes}, incremental_{incremental} {}
+    std::string nextGuess(const SolverState & state) const override;
+  private:
+    std::shared_ptr<const PartitionScorer> scorer_;
+    size_t probes_;
+    bool incremental_; // rank probes through PartitionCounts
+};
+
+std::string EndgameStrategy::nextGuess(const SolverState & state) const {
+  std::vector<std::string> words(state.possibleAnswers.begin(), state.possibleAnswers.end());
+  std::sort(words.begin(), words.end());
+
+  std::vector<std::string> probes;
+  if (scorer_ != nullptr && probes_ > 0) {
+    for (const ScoredGuess & scored : rankGuesses(state, words, scorer_, probes_, incremental_)) {
+      if (!scored.candidate) probes.push_back(scorer_->word(scored.guess));
+    }
+  }
+
+  std::string guess;
+  endgameTotalGuesses(words, &guess, probes);
+  return guess;
+}
+
+struct TierThresholds {
+  size_t endgameMax{20}; // <= endgameMax candidates -> exhaustive endgame
+  size_t partitionMax{100}; // <= partitionMax candidates -> exact partition scoring
+  size_t endgameProbes{16}; // best partitioning allowed guesses also tried as first endgame guess
+  bool incrementalCounts{false}; // keep feedback bucket counts across rounds (see rankGuesses), |allowed| x 486 bytes per game, capped by kPartitionCountsBudget
+  ScoringPolicy partitionPolicy{EXPECTED_SIZE_POLICY}; // objective of the partition tier
+};
+
+/*     picks a strategy per round by solution set size     */
+class TieredStrategy : public GuessStrategy {
+  public:
+    TieredStrategy(TierThresholds thresholds, std::vector<std::string> allowedGuesses) // ctor
+      : TieredStrategy{thresholds, std::make_shared<const PartitionScorer>(std::move(allowedGuesses))} {}
+    TieredStrategy(TierThresholds thresholds, std::shared_ptr<const PartitionScorer> scorer) // ctor, shares "scorer"
+      : thresholds_{thresholds},
+        scorer_{std::move(scorer)},
+        endgame_{scorer_, thresholds.endgameProbes, thresholds.incrementalCounts},
+        partition_{makePolicyStrategy(thresholds.partitionPolicy, scorer_, thresholds.incrementalCounts)} {
+      thresholds_.endgameMax = std::min<size_t>(thresholds_.endgameMax, 32);
+    }
+    const std::shared_ptr<const PartitionScorer> & scorer() const { return scorer_; }
+    const TierThresholds & thresholds() const { return thresholds_; }
+    std::string nextGuess(const SolverState & state) const override {
+      size_t size = state.possibleAnswers.size();
+      if (size <= thresholds_.endgameMax) return endgame_.nextGuess(state);
+      if (size <= thresholds_.partitionMax) return partition_->nextGuess(state);
+      return frequency_.nextGuess(state);
+    }
+  private:
+    TierThresholds thresholds_;
+    std::shared_ptr<const PartitionScorer> scorer_;
+    EndgameStrategy endgame_;
+    std::unique_ptr<GuessStrategy> partition_;
+    PositionalFrequencyStrategy frequency_;
+};
+
+/*     every word of the epoch is an allowed guess     */
+const TieredStrategy & DictionaryEpoch::strategy() const {
+  std::call_once(strategyOnce_, [this]() {
+    strategy_ = std::make_shared<const TieredStrategy>(TierThresholds{}, index().words());
+    strategyBuilt_.store(true, std::memory_order_release);
+  });
+  return *strategy_;
+}
+
+/*     a built strategy hands its packed words on, so the first game on the next epoch doesn't repack the list     */
+void DictionaryEpoch::handOnStrategy(const DictionaryEpoch & next, const std::vector<std::string> & added, const std::vector<std::string> & removed) const {
+  if (!strategyBuilt_.load(std::memory_order_acquire)) return;
+  std::shared_ptr<const PartitionScorer> scorer = strategy_->scorer()->patched(added, removed);
+  std::call_once(next.strategyOnce_, [&]() {
+    next.strategy_ = std::make_shared<const TieredStrategy>(TierThresholds{}, std::move(scorer));
+    next.strategyBuilt_.store(true, std::memory_order_release);
+  });
+}
+
+/*     solveGame() -> SolveWordle() against anything with a Wordle-style CharacterizeWord()     */
+template <class Oracle>
+std::string solveGame(const Oracle& wordle, const GuessStrategy& strategy, GameTrace* trace) {
+  /*     the oracle's epoch: a reload mid-game doesn't change this one     */
+  std::shared_ptr<const DictionaryEpoch> dictionary = wordle.dictionary();
+
+  SolverState state;
+  std::string guess = dictionary->openingGuess(); 
+  WordleLetterStates states;
+  std::shared_ptr<const OpeningBucket> opening; // set by the first round
+
+  /*     iterating guesses     */
+  while ((opening ? state.possibleAnswers.size() : dictionary->words().size()) > 1) {
+    TraceStep step;
+    step.candidatesBefore = static_cast<uint32_t>(opening ? state.possibleAnswers.size() : dictionary->words().size());
+    auto stageStart = std::chrono::steady_clock::now();
+
+    states = wordle.CharacterizeWord(guess);
+    step.characterizeNs = elapsedNs(stageStart);
+
+    /*     first round: the epoch's cached state for this feedback, otherwise classify + reduce     */
+    stageStart = std::chrono::steady_clock::now();
+    bool first = !opening;
+    if (first) {
+      opening = dictionary->afterOpening(encodeFeedback(states));
+      state = opening->state;
+    } else {
+      narrowByFeedback(state, guess, states);
+    }
+    step.reduceNs = elapsedNs(stageStart);
+    step.candidatesAfter = static_cast<uint32_t>(state.possibleAnswers.size());
+
+    if (trace != nullptr) {
+      step.guess = dictionary->index().id(guess);
+      step.feedback = encodeFeedback(states);
+      trace->steps.push_back(step);
+    }
+  
+    /*     error catching: no candidate left, or a guess that would be played again forever     */
+    if (state.possibleAnswers.size() == 0) failSolve(state, guess, states, dictionary->alphabet());
+    if (step.candidatesAfter >= step.candidatesBefore) throw std::logic_error{"Guess " + decodeWord(guess, dictionary->alphabet()) + " did not narrow the candidates."};
+
+    stageStart = std::chrono::steady_clock::now();
+    guess = first ? opening->nextGuess(strategy, state) : strategy.nextGuess(state);
+    if (trace != nullptr) trace->steps.back().pickNs = elapsedNs(stageStart);
+  } 
+
+  if (trace != nullptr) {
+    trace->dictionary = dictionary->index().fingerprint();
+    trace->result = dictionary->index().id(guess);
+  }
+
+#ifndef WORDLE_LIBRARY
+  std::cout << "Word: " << decodeWord(guess, dictionary->alphabet()) << std::endl;
+#endif
+  return guess;
+}
+
+/*     SolveWordle() -> returns answer to wordle game, optionally recording each step into "trace"     */
+std::string SolveWordle(const Wordle& wordle, const GuessStrategy& strategy, GameTrace* trace = nullptr) {
+  return solveGame(wordle, strategy, trace);
+}
+
+/*     with the default strategy of the game's epoch     */
+std::string SolveWordle(const Wordle& wordle, GameTrace* trace = nullptr) {
+  return SolveWordle(wordle, wordle.dictionary()->strategy(), trace);
+}
+
+/*     guesses actually played, the returned word costs one more unless it was the last guess     */
+size_t guessCount(const GameTrace & trace) {
+  if (trace.steps.empty()) return 1;
+  return trace.steps.size() + (trace.steps.back().feedback == kAllCorrect ? 0 : 1);
+}
+
+/* ======================= ADVERSARIAL ORACLE ======================= */
+
+/*
+  Wordle that never commits to an answer (Absurdle-style): every guess splits the words still
+  possible by feedback (same duplicate-letter rules as CharacterizeWord(), via packedFeedback())
+  and the oracle answers with the pattern that keeps the largest bucket, or with HARDEST_BUCKET,
+  the one among the largest few that the best next guess splits worst. Ties go to the lowest
+  feedback code, so every strategy gets the same reproducible worst-case game.
+*/
+
+enum AdversaryMode {
+  LARGEST_BUCKET = 0,
+  HARDEST_BUCKET = 1
+};
+
+class AdversarialWordle {
+  public:
+    AdversarialWordle(const std::vector<std::string> & candidates, AdversaryMode mode = LARGEST_BUCKET, std::shared_ptr<const PartitionScorer> scorer = nullptr); // ctor
+    WordleLetterStates CharacterizeWord(const std::string& query) const; // evaluate guess, narrows the hidden set
+    size_t remaining() const { return candidates_.size(); }
+    std::string answer() const; // lowest remaining word, the answer once remaining() == 1
+    size_t guesses() const { return counter_; }
+    const std::shared_ptr<const DictionaryEpoch> & dictionary() const { return dictionary_; }
+  private:
+    AdversaryMode mode_;
+    std::shared_ptr<const DictionaryEpoch> dictionary_; // guesses are validated against the epoch at construction
+    std::shared_ptr<const PartitionScorer> scorer_; // HARDEST_BUCKET only
+    mutable std::vector<PackedWord> candidates_; // words consistent with every answer so far, sorted
+    mutable std::vector<uint32_t> ids_; // HARDEST_BUCKET only: scorer id of each candidate
+    mutable std::vector<uint32_t> bucketIds_; // HARDEST_BUCKET only: sorted ids of the bucket being scored
+    mutable size_t counter_{0}; // # of guesses
+};
+
+/*     candidates (HARDEST_BUCKET) looks at, by size     */
+constexpr size_t kHardestBucketsConsidered = 4;
+
+void ValidateWord(const std::string& word, const DictionaryEpoch& dictionary);
+void ValidateStates(const WordleLetterStates& states);
+
+std::string unpackWord(PackedWord packed) {
+  std::string word(5, ' ');
+  for (size_t idx = 0; idx < 5; ++idx) word[idx] = static_cast<char>((packed >> (8 * idx)) & 0xff);
+  return word;
+}
+
+AdversarialWordle::AdversarialWordle(const std::vector<std::string> & candidates, AdversaryMode mode, std::shared_ptr<const PartitionScorer> scorer)
+  : mode_{mode}, dictionary_{currentDictionary()}, scorer_{std::move(scorer)} {
+  for (const std::string & word : candidates) candidates_.push_back(packWord(word));
+  std::sort(candidates_.begin(), candidates_.end());
+  candidates_.erase(std::unique(candidates_.begin(), candidates_.end()), candidates_.end());
+  if (candidates_.empty()) throw std::logic_error{"Adversary needs at least one candidate."};
+  if (mode_ != HARDEST_BUCKET) return;
+  if (scorer_ == nullptr) scorer_ = std::make_shared<const PartitionScorer>(candidates);
+  for (PackedWord word : candidates_) {
+    std::optional<std::vector<uint32_t>> id = scorer_->ids({unpackWord(word)});
+    if (!id) throw std::logic_error{"Adversary candidate " + unpackWord(word) + " is not an allowed guess of its scorer."};
+    ids_.push_back(id->front());
+  }
+}
+
+std::string AdversarialWordle::answer() const {
+  return unpackWord(candidates_.front());
+}
+
+WordleLetterStates AdversarialWordle::CharacterizeWord(const std::string& query) const {
+  counter_++;
+  ValidateWord(query, *dictionary_);
+  const PackedWord guess = packWord(query);
+
+  std::vector<FeedbackCode> codes(candidates_.size());
+  std::array<uint32_t, kNumFeedbackCodes> buckets{};
+  for (size_t idx = 0; idx < candidates_.size(); ++idx) {
+    codes[idx] = packedFeedback(guess, candidates_[idx]);
+    buckets[codes[idx]]++;
+  }
+
+  /*     largest bucket, lowest code on ties     */
+  std::vector<FeedbackCode> order;
+  for (size_t code = 0; code < kNumFeedbackCodes; ++code) {
+    if (buckets[code] != 0) order.push_back(static_cast<FeedbackCode>(code));
+  }
+  std::stable_sort(order.begin(), order.end(), [&](FeedbackCode a, FeedbackCode b) { return buckets[a] > buckets[b]; });
+  FeedbackCode chosen = order.front();
+
+  /*     of the largest few, the bucket whose best split is worst     */
+  if (mode_ == HARDEST_BUCKET && order.size() > 1) {
+    uint64_t hardest = 0;
+    for (size_t rank = 0; rank < std::min(order.size(), kHardestBucketsConsidered); ++rank) {
+      bucketIds_.clear();
+      for (size_t idx = 0; idx < candidates_.size(); ++idx) {
+        if (codes[idx] == order[rank]) bucketIds_.push_back(ids_[idx]);
+      }
+      std::sort(bucketIds_.begin(), bucketIds_.end());
+      ScoredGuess best;
+      uint64_t score = scorer_->topGuesses(bucketIds_, 1, &best) == 1 ? best.score : uint64_t(bucketIds_.size()) * bucketIds_.size();
+      if (score > hardest) {
+        hardest = score;
+        chosen = order[rank];
+      }
+    }
+  }
+
+  size_t kept = 0;
+  for (size_t idx = 0; idx < candidates_.size(); ++idx) {
+    if (codes[idx] != chosen) continue;
+    candidates_[kept] = candidates_[idx];
+    if (!ids_.empty()) ids_[kept] = ids_[idx];
+    kept++;
+  }
+  candidates_.resize(kept);
+  if (!ids_.empty()) ids_.resize(kept);
+
+  WordleLetterStates states = decodeFeedback(chosen);
+  ValidateStates(states);
+  return states;
+}
+
+/* ========================== TRACE REPLAY ========================== */
+
+/*     mean (replayed - recorded) time per stage for one step number     */
+struct StepTimingDelta {
+  size_t samples{0};
+  double characterizeNs{0};
+  double reduceNs{0};
+  double pickNs{0};
+};
+
+struct ReplayReport {
+  size_t games{0};
+  size_t failedGames{0}; // replay threw or returned the wrong word
+  std::vector<std::pair<size_t, size_t>> divergences; // (game index, first divergent step)
+  std::vector<StepTimingDelta> stepDeltas; // indexed by step number, matching steps only
+};
+
+/*     re-runs every traced game through the current solver     */
+ReplayReport replayTrace(const std::vector<GameTrace> & games, const WordIndex & index) {
+  ReplayReport report;
+  std::vector<StepTimingDelta> sums;
+
+  for (size_t gameIdx = 0; gameIdx < games.size(); ++gameIdx) {
+    const GameTrace & recorded = games[gameIdx];
+    GameTrace replayed;
+    replayed.answer = recorded.answer;
+    report.games++;
+
+    bool threw = false;
+    try {
+      if (recorded.answer >= index.size()) throw std::logic_error{"Word id " + std::to_string(recorded.answer) + " is out of range."};
+      Wordle wordle{index.word(recorded.answer)};
+      SolveWordle(wordle, &replayed);
+      if (replayed.dictionary != index.fingerprint()) throw std::logic_error{"Replayed on another dictionary."};
+    } catch (const std::exception &) {
+      replayed.result = kInvalidWordId;
+      threw = true;
+    }
+    if (threw || replayed.result != replayed.answer) report.failedGames++;
+
+    /*     compare guess by guess, timings only while both runs agree     */
+    size_t common = std::min(recorded.steps.size(), replayed.steps.size());
+    size_t stepIdx = 0;
+    for (; stepIdx < common; ++stepIdx) {
+      const TraceStep & before = recorded.steps[stepIdx];
+      const TraceStep & after = replayed.steps[stepIdx];
+      if (before.guess != after.guess || before.feedback != after.feedback) break;
+
+      if (sums.size() <= stepIdx) sums.resize(stepIdx + 1);
+      sums[stepIdx].samples++;
+      sums[stepIdx].characterizeNs += double(after.characterizeNs) - double(before.characterizeNs);
+      sums[stepIdx].reduceNs += double(after.reduceNs) - double(before.reduceNs);
+      sums[stepIdx].pickNs += double(after.pickNs) - double(before.pickNs);
+    }
+    if (stepIdx != recorded.steps.size() || stepIdx != replayed.steps.size() || recorded.result != replayed.result) {
+      report.divergences.emplace_back(gameIdx, stepIdx);
+    }
+  }
+
+  for (StepTimingDelta & delta : sums) {
+    delta.characterizeNs /= double(delta.samples);
+    delta.reduceNs /= double(delta.samples);
+    delta.pickNs /= double(delta.samples);
+  }
+  report.stepDeltas = std::move(sums);
+  return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const ReplayReport& report) {
+  os << "Replayed " << report.games << " games, " << report.divergences.size() << " divergent, "
+     << report.failedGames << " failed" << std::endl;
+  for (const auto & divergence : report.divergences) {
+    os << "  game " << divergence.first << " diverges at step " << divergence.second << std::endl;
+  }
+  for (size_t stepIdx = 0; stepIdx < report.stepDeltas.size(); ++stepIdx) {
+    const StepTimingDelta & delta = report.stepDeltas[stepIdx];
+    os << "  step " << stepIdx << " (" << delta.samples << " games): characterize " << delta.characterizeNs
+       << " ns, reduce " << delta.reduceNs << " ns, pick " << delta.pickNs << " ns" << std::endl;
+  }
+  return os;
+}
+
+/* ======================== PIPELINED SOLVER ======================== */
+
+/*
+  When feedback comes from a remote oracle, SolveWordle() spends nearly all of its time blocked in
+  CharacterizeWord(). solveWordleAsync() is the same loop as a C++20 coroutine: each guess suspends
+  the game until its feedback arrives. PipelineScheduler keeps many games in flight on a few threads
+  and sends their guesses to the oracle in batches, so one round trip is paid per batch instead of
+  per guess.
+*/
+
+struct FeedbackRequest {
+  size_t game; // game handle understood by the oracle
+  std::string guess;
+};
+
+/*     feedback provider with real latency, answers whole batches asynchronously     */
+class AsyncFeedbackOracle {
+  public:
+    using Callback = std::function<void(std::vector<WordleLetterStates>)>;
+    virtual ~AsyncFeedbackOracle() = default;
+
+    /*     calls "done" exactly once, from any thread, with one result per request (INVALID states on failure)     */
+    virtual void submit(std::vector<FeedbackRequest> batch, Callback done) = 0;
+};
+
+class PipelineScheduler;
+
+/*     coroutine type of solveWordleAsync(), owned and destroyed by the scheduler     */
+struct SolveTask {
+  struct promise_type {
+    PipelineScheduler * scheduler{nullptr};
+    size_t game{0};
+    std::string result;
+    std::exception_ptr error;
+
+    /*     reports the finished game to the scheduler, which destroys the frame     */
+    struct FinalAwaiter {
+      bool await_ready() const noexcept { return false; }
+      void await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+      void await_resume() const noexcept {}
+    };
+
+    SolveTask get_return_object() { return SolveTask{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+    void return_value(std::string word) { result = std::move(word); }
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  std::coroutine_handle<promise_type> handle;
+};
+
+/*     co_await'ed for each guess, the game resumes once the oracle answered     */
+struct FeedbackAwaiter {
+  PipelineScheduler & scheduler;
+  size_t game;
+  std::string guess;
+  WordleLetterStates states{}; // filled in by the scheduler before resuming
+
+  bool await_ready() const noexcept { return false; }
+  void await_suspend(std::coroutine_handle<> handle);
+  WordleLetterStates await_resume() const { ValidateStates(states); return states; }
+};
+
+struct PipelineConfig {
+  size_t threads{2}; // threads resuming games
+  size_t maxBatch{256}; // guesses per oracle call
+  size_t maxGamesInFlight{4096}; // bounds memory, every game owns a solution set
+};
+
+class PipelineScheduler {
+  public:
+    PipelineScheduler(AsyncFeedbackOracle & oracle, PipelineConfig config = {}, const GuessStrategy * strategy = nullptr); // ctor, nullptr -> each game's epoch strategy
+    std::vector<std::string> solveAll(size_t numGames); // solved word per game, rethrows the first failure
+    FeedbackAwaiter feedback(size_t game, std::string guess) { return FeedbackAwaiter{*this, game, std::move(guess)}; }
+  private:
+    friend struct FeedbackAwaiter;
+    friend struct SolveTask::promise_type::FinalAwaiter;
+
+    struct Outgoing {
+      FeedbackAwaiter * awaiter;
+      std::coroutine_handle<> handle;
+    };
+
+    void request(FeedbackAwaiter * awaiter, std::coroutine_handle<> handle);
+    void complete(std::coroutine_handle<SolveTask::promise_type> handle);
+    void flushLocked(std::unique_lock<std::mutex> & lock); // sends queued guesses, lock released during submit
+    void admitLocked(); // starts new games while under maxGamesInFlight
+    void workerLoop();
+
+    AsyncFeedbackOracle & oracle_;
+    PipelineConfig config_;
+    const GuessStrategy * strategy_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::coroutine_handle<>> ready_; // games with feedback waiting to be resumed
+    std::vector<Outgoing> outgoing_; // guesses not yet sent to the oracle
+    size_t running_{0}; // games currently being resumed
+    size_t nextGame_{0};
+    size_t numGames_{0};
+    size_t inFlight_{0};
+    size_t finished_{0};
+    std::vector<std::string> results_;
+    std::exception_ptr error_;
+};
+
+/*     solveWordleAsync() -> SolveWordle() loop, suspending on every guess     */
+SolveTask solveWordleAsync(PipelineScheduler & scheduler, size_t game, std::shared_ptr<const DictionaryEpoch> dictionary, const GuessStrategy * chosen) {
+  const GuessStrategy & strategy = chosen != nullptr ? *chosen : dictionary->strategy();
+  SolverState state;
+  std::string guess = dictionary->openingGuess();
+  std::shared_ptr<const OpeningBucket> opening;
+
+  while ((opening ? state.possibleAnswers.size() : dictionary->words().size()) > 1) {
+    size_t before = opening ? state.possibleAnswers.size() : dictionary->words().size();
+    WordleLetterStates states = co_await scheduler.feedback(game, guess);
+    bool first = !opening;
+    if (first) {
+      opening = dictionary->afterOpening(encodeFeedback(states));
+      state = opening->state;
+    } else {
+      narrowByFeedback(state, guess, states);
+    }
+    if (state.possibleAnswers.size() == 0) failSolve(state, guess, states, dictionary->alphabet());
+    if (state.possibleAnswers.size() >= before) throw std::logic_error{"Guess " + decodeWord(guess, dictionary->alphabet()) + " did not narrow the candidates."};
+    guess = first ? opening->nextGuess(strategy, state) : strategy.nextGuess(state);
+  }
+
+  co_return guess;
+}
+
+void SolveTask::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+  handle.promise().scheduler->complete(handle);
+}
+
+void FeedbackAwaiter::await_suspend(std::coroutine_handle<> handle) {
+  /*     the game may be resumed on another thread before this returns, don't touch "this" afterwards     */
+  scheduler.request(this, handle);
+}
+
+PipelineScheduler::PipelineScheduler(AsyncFeedbackOracle & oracle, PipelineConfig config, const GuessStrategy * strategy)
+  : oracle_{oracle}, config_{config}, strategy_{strategy} {
+  config_.threads = std::max<size_t>(config_.threads, 1);
+  config_.maxBatch = std::max<size_t>(config_.maxBatch, 1);
+  config_.maxGamesInFlight = std::max<size_t>(config_.maxGamesInFlight, 1);
+}
+
+std::vector<std::string> PipelineScheduler::solveAll(size_t numGames) {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    results_.assign(numGames, std::string{});
+    numGames_ = numGames;
+    nextGame_ = 0;
+    finished_ = 0;
+    error_ = nullptr;
+    admitLocked();
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < config_.threads; ++t) threads.emplace_back([this]() { workerLoop(); });
+  workerLoop();
+  for (auto & thread : threads) thread.join();
+
+  if (error_) std::rethrow_exception(error_);
+  return std::move(results_);
+}
+
+void PipelineScheduler::admitLocked() {
+  while (inFlight_ < config_.maxGamesInFlight && nextGame_ < numGames_) {
+    SolveTask task = solveWordleAsync(*this, nextGame_, currentDictionary(), strategy_); // new games take the latest epoch
+    task.handle.promise().scheduler = this;
+    task.handle.promise().game = nextGame_;
+    ready_.push_back(task.handle);
+    inFlight_++;
+    nextGame_++;
+  }
+}
+
+void PipelineScheduler::workerLoop() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (true) {
+    wake_.wait(lock, [this]() { return !ready_.empty() || finished_ == numGames_; });
+    if (ready_.empty()) return; // every game finished
+
+    std::coroutine_handle<> handle = ready_.front();
+    ready_.pop_front();
+    running_++;
+    lock.unlock();
+    handle.resume();
+    lock.lock();
+    running_--;
+
+    /*     nothing left to run until the oracle answers -> send whatever is queued     */
+    if (ready_.empty() && running_ == 0 && !outgoing_.empty()) flushLocked(lock);
+  }
+}
+
+void PipelineScheduler::request(FeedbackAwaiter * awaiter, std::coroutine_handle<> handle) {
+  std::unique_lock<std::mutex> lock{mutex_};
+  outgoing_.push_back(Outgoing{awaiter, handle});
+  if (outgoing_.size() >= config_.maxBatch) flushLocked(lock);
+}
+
+void PipelineScheduler::flushLocked(std::unique_lock<std::mutex> & lock) {
+  std::vector<Outgoing> sending;
+  std::swap(sending, outgoing_);
+  lock.unlock();
+
+  std::vector<FeedbackRequest> batch;
+  batch.reserve(sending.size());
+  for (const Outgoing & out : sending) batch.push_back(FeedbackRequest{out.awaiter->game, out.awaiter->guess});
+
+  oracle_.submit(std::move(batch), [this, sending = std::move(sending)](std::vector<WordleLetterStates> results) {
+    std::lock_guard<std::mutex> resultLock{mutex_};
+    for (size_t idx = 0; idx < sending.size(); ++idx) {
+      if (idx < results.size()) sending[idx].awaiter->states = results[idx];
+      else sending[idx].awaiter->states.fill(INVALID);
+      ready_.push_back(sending[idx].handle);
+    }
+    wake_.notify_all();
+  });
+
+  lock.lock();
+}
+
+void PipelineScheduler::complete(std::coroutine_handle<SolveTask::promise_type> handle) {
+  SolveTask::promise_type & promise = handle.promise();
+  std::lock_guard<std::mutex> lock{mutex_};
+  results_[promise.game] = std::move(promise.result);
+  if (promise.error && !error_) error_ = promise.error;
+  handle.destroy();
+
+  inFlight_--;
+  finished_++;
+  admitLocked();
+  wake_.notify_all();
+}
+
+/*     in-memory stand-in for a remote oracle: each batch is answered after latency +/- jitter     */
+class LatencyOracle : public AsyncFeedbackOracle {
+  public:
+    LatencyOracle(const std::vector<std::string> & answers, std::chrono::microseconds latency, std::chrono::microseconds jitter, unsigned seed); // ctor
+    ~LatencyOracle() override; // dtor, drops unanswered batches
+    void submit(std::vector<FeedbackRequest> batch, Callback done) override;
+    size_t batches() const { return batches_; }
+    size_t requests() const { return requests_; }
+  private:
+    using Clock = std::chrono::steady_clock;
+    void timerLoop();
+
+    std::vector<std::unique_ptr<Wordle>> games_;
+    std::chrono::microseconds latency_;
+    std::chrono::microseconds jitter_;
+    std::mt19937 rng_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::multimap<Clock::time_point, std::pair<std::vector<FeedbackRequest>, Callback>> inFlight_; // by due time
+    bool stopping_{false};
+    std::atomic<size_t> batches_{0};
+    std::atomic<size_t> requests_{0};
+    std::thread timer_;
+};
+
+LatencyOracle::LatencyOracle(const std::vector<std::string> & answers, std::chrono::microseconds latency, std::chrono::microseconds jitter, unsigned seed)
+  : latency_{latency}, jitter_{jitter}, rng_{seed} {
+  for (const std::string & answer : answers) games_.push_back(std::make_unique<Wordle>(answer));
+  timer_ = std::thread{[this]() { timerLoop(); }};
+}
+
+LatencyOracle::~LatencyOracle() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  timer_.join();
+}
+
+void LatencyOracle::submit(std::vector<FeedbackRequest> batch, Callback done) {
+  batches_++;
+  requests_ += batch.size();
+
+  std::lock_guard<std::mutex> lock{mutex_};
+  std::uniform_int_distribution<long long> spread(-jitter_.count(), jitter_.count());
+  auto delay = std::max(std::chrono::microseconds{0}, latency_ + std::chrono::microseconds{spread(rng_)});
+  inFlight_.emplace(Clock::now() + delay, std::make_pair(std::move(batch), std::move(done)));
+  wake_.notify_all();
+}
+
+void LatencyOracle::timerLoop() {
+  std::unique_lock<std::mutex> lock{mutex_};
+  while (!stopping_) {
+    if (inFlight_.empty()) {
+      wake_.wait(lock);
+      continue;
+    }
+    auto due = inFlight_.begin()->first;
+    if (Clock::now() < due) {
+      wake_.wait_until(lock, due);
+      continue;
+    }
+
+    auto batch = std::move(inFlight_.begin()->second);
+    inFlight_.erase(inFlight_.begin());
+    lock.unlock();
+
+    std::vector<WordleLetterStates> results(batch.first.size());
+    for (size_t idx = 0; idx < batch.first.size(); ++idx) {
+      const FeedbackRequest & req = batch.first[idx];
+      try {
+        results[idx] = games_.at(req.game)->CharacterizeWord(req.guess);
+      } catch (const std::exception &) {
+        results[idx].fill(INVALID);
+      }
+    }
+    batch.second(std::move(results));
+
+    lock.lock();
+  }
+}
+
+/* ========================= SHARDED SWEEP ========================= */
+
+/*
+  A strategy sweep (every answer through SolveWordle, for every strategy configuration) split
+  across worker processes, on one host or several.
+
+  - writeSweepTables() dumps the packed dictionary and its word x word feedback table once, every
+    worker mmaps it read-only and scores straight out of the mapping through one PartitionScorer
+    shared by all its configurations, so the table is computed once and its pages are shared by
+    every worker on the host; games are still validated against the worker's own dictionary,
+    whose fingerprint must match
+  - SweepCoordinator listens on "unix:<path>" or "tcp:<host>:<port>", hands out shards
+    (configuration, answer id range) to whichever worker is idle, and re-issues a shard when its
+    worker disconnects or takes longer than shardTimeout
+  - runSweepWorker() connects, solves shards until told to stop; a worker whose result frame
+    doesn't decode is dropped like one that crashed
+  - results are merged in shard order, so the output doesn't depend on which worker ran what
+
+  Frames are a u32 length followed by the payload, first payload byte is the message type.
+*/
+
+constexpr char kTablesMagic[4] = {'W', 'S', 'W', 'P'};
+constexpr uint32_t kTablesVersion = 2;
+constexpr size_t kTablesHeaderBytes = 20;
+
+/*     rows of the feedback table computed (in parallel) between two writes     */
+constexpr size_t kTablesRowsPerWrite = 256;
+
+/*
+      "WSWP" | u32 version | u64 dictionary fingerprint | u32 word count N
+    | u64 packed word per id | N x N feedback codes, row = guess id, column = answer id
+*/
+void writeSweepTables(const std::string & path, const WordIndex & index, size_t threads = std::thread::hardware_concurrency()) {
+  const size_t n = index.size();
+  std::vector<PackedWord> packed;
+  packed.reserve(n);
+  for (const std::string & word : index.words()) packed.push_back(packWord(word));
+
+  std::string bytes(kTablesMagic, sizeof(kTablesMagic));
+  appendLE(bytes, kTablesVersion, 4);
+  appendLE(bytes, index.fingerprint(), 8);
+  appendLE(bytes, n, 4);
+  for (PackedWord word : packed) appendLE(bytes, word, 8);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out.write(bytes.data(), bytes.size())) throw std::logic_error{"Could not write sweep tables " + path};
+  std::vector<FeedbackCode> rows;
+  for (size_t first = 0; first < n; first += kTablesRowsPerWrite) {
+    size_t count = std::min(kTablesRowsPerWrite, n - first);
+    rows.resize(count * n);
+    parallelFor(count, threads, [&](size_t row) {
+      for (size_t answer = 0; answer < n; ++answer) rows[row * n + answer] = packedFeedback(packed[first + row], packed[answer]);
+    });
+    if (!out.write(reinterpret_cast<const char *>(rows.data()), rows.size())) throw std::logic_error{"Could not write sweep tables " + path};
+  }
+  if (!out.flush()) throw std::logic_error{"Could not write sweep tables " + path};
+}
+
+/*     read-only, mmap'ed view of writeSweepTables() output     */
+class SweepTables {
+  public:
+    explicit SweepTables(const std::string & path); // ctor, throws if missing or malformed
+    uint64_t fingerprint() const { return readLE(bytes() + 8, 8); }
+    size_t size() const { return size_; }
+    std::string word(WordId id) const; // unpacks one word
+    std::vector<std::string> words() const; // every word, by id
+    const FeedbackCode * feedback() const { return bytes() + kTablesHeaderBytes + size_ * 8; } // size() x size(), in the mapping
+  private:
+    const unsigned char * bytes() const { return reinterpret_cast<const unsigned char *>(file_.data()); }
+    MappedFile file_;
+    size_t size_{0};
+};
+
+SweepTables::SweepTables(const std::string & path) : file_{path} {
+  if (!file_.isOpen() || file_.size() < kTablesHeaderBytes || std::memcmp(file_.data(), kTablesMagic, 4) != 0 || readLE(bytes() + 4, 4) != kTablesVersion) {
+    throw std::logic_error{"Invalid sweep tables " + path};
+  }
+  size_ = readLE(bytes() + 16, 4);
+  if (file_.size() != kTablesHeaderBytes + size_ * 8 + size_ * size_) throw std::logic_error{"Truncated sweep tables " + path};
+}
+
+std::string SweepTables::word(WordId id) const {
+  uint64_t packed = readLE(bytes() + kTablesHeaderBytes + size_t{id} * 8, 8);
+  std::string word(5, ' ');
+  for (size_t idx = 0; idx < 5; ++idx) word[idx] = static_cast<char>((packed >> (8 * idx)) & 0xff);
+  return word;
+}
+
+std::vector<std::string> SweepTables::words() const {
+  std::vector<std::string> words;
+  words.reserve(size_);
+  for (WordId id = 0; id < size_; ++id) words.push_back(word(id));
+  return words;
+}
+
+enum SweepMessage : uint8_t {
+  SWEEP_SHARD = 1, // coordinator -> worker: u32 shard | u32 begin | u32 end | u32 endgameMax | u32 partitionMax | u32 probes | u32 incremental | u32 policy
+  SWEEP_RESULT = 2, // worker -> coordinator: u32 shard | u32 failures | u32 worst | u32 #worst | ids | u16 #bins | u32 bins
+  SWEEP_DONE = 3 // coordinator -> worker: shut down
+};
+
+/*     guess-count histogram + worst cases over some answers     */
+struct SweepResult {
+  std::vector<uint64_t> histogram; // index = guesses in the game
+  uint64_t games{0};
+  uint64_t failures{0}; // solver threw or returned the wrong word
+  size_t worstGuesses{0};
+  std::vector<WordId> worstAnswers; // sorted
+
+  void merge(const SweepResult & other);
+};
+
+void SweepResult::merge(const SweepResult & other) {
+  if (histogram.size() < other.histogram.size()) histogram.resize(other.histogram.size());
+  for (size_t idx = 0; idx < other.histogram.size(); ++idx) histogram[idx] += other.histogram[idx];
+  games += other.games;
+  failures += other.failures;
+
+  if (other.worstGuesses > worstGuesses) {
+    worstGuesses = other.worstGuesses;
+    worstAnswers.clear();
+  }
+  if (other.worstGuesses == worstGuesses) {
+    worstAnswers.insert(worstAnswers.end(), other.worstAnswers.begin(), other.worstAnswers.end());
+    std::sort(worstAnswers.begin(), worstAnswers.end());
+  }
+}
+
+/*     solveSweepRange() -> play answers [begin, end) with one configuration     */
+SweepResult solveSweepRange(const GuessStrategy & strategy, const std::function<std::string(WordId)> & answerOf, WordId begin, WordId end) {
+  SweepResult result;
+  for (WordId id = begin; id < end; ++id) {
+    const std::string answer = answerOf(id);
+    size_t guesses = 0;
+    try {
+      Wordle wordle{answer};
+      GameTrace trace;
+      if (SolveWordle(wordle, strategy, &trace) != answer) result.failures++;
+      guesses = guessCount(trace);
+    } catch (const std::exception &) {
+      result.failures++;
+    }
+
+    if (result.histogram.size() <= guesses) result.histogram.resize(guesses + 1);
+    result.histogram[guesses]++;
+    result.games++;
+    if (guesses > result.worstGuesses) {
+      result.worstGuesses = guesses;
+      result.worstAnswers.clear();
+    }
+    if (guesses == result.worstGuesses) result.worstAnswers.push_back(id);
+  }
+  return result;
+}
+
+/* ---------------- sockets ---------------- */
+
+/*     "unix:<path>" or "tcp:<host>:<port>" -> sockaddr     */
+struct SweepEndpoint {
+  sockaddr_storage address{};
+  socklen_t length{0};
+  int family{AF_UNIX};
+};
+
+SweepEndpoint parseEndpoint(const std::string & endpoint) {
+  SweepEndpoint parsed;
+  if (endpoint.rfind("unix:", 0) == 0) {
+    std::string path = endpoint.substr(5);
+    sockaddr_un * addr = reinterpret_cast<sockaddr_un *>(&parsed.address);
+    if (path.size() >= sizeof(addr->sun_path)) throw std::logic_error{"Socket path too long: " + path};
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, path.c_str(), path.size() + 1);
+    parsed.length = sizeof(sockaddr_un);
+    parsed.family = AF_UNIX;
+    return parsed;
+  }
+  if (endpoint.rfind("tcp:", 0) == 0) {
+    size_t colon = endpoint.rfind(':');
+    sockaddr_in * addr = reinterpret_cast<sockaddr_in *>(&parsed.address);
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(static_cast<uint16_t>(std::stoi(endpoint.substr(colon + 1))));
+    if (::inet_pton(AF_INET, endpoint.substr(4, colon - 4).c_str(), &addr->sin_addr) != 1) {
+      throw std::logic_error{"Invalid address in " + endpoint};
+    }
+    parsed.length = sizeof(sockaddr_in);
+    parsed.family = AF_INET;
+    return parsed;
+  }
+  throw std::logic_error{"Unknown endpoint " + endpoint};
+}
+
+bool sendFrame(int fd, const std::string & payload) {
+  std::string frame;
+  appendLE(frame, payload.size(), 4);
+  frame += payload;
+  for (size_t sent = 0; sent < frame.size();) {
+    ssize_t n = ::send(fd, frame.data() + sent, frame.size() - sent, MSG_NOSIGNAL);
+    if (n <= 0) return false;
+    sent += static_cast<size_t>(n);
+  }
+  return true;
+}
+
+/*     pops one complete frame off "buffer" if there is one     */
+bool takeFrame(std::string & buffer, std::string & payload) {
+  if (buffer.size() < 4) return false;
+  size_t length = readLE(reinterpret_cast<const unsigned char *>(buffer.data()), 4);
+  if (buffer.size() < 4 + length) return false;
+  payload = buffer.substr(4, length);
+  buffer.erase(0, 4 + length);
+  return true;
+}
+
+/*     blocking read of one frame, false on EOF/error     */
+bool recvFrame(int fd, std::string & buffer, std::string & payload) {
+  while (!takeFrame(buffer, payload)) {
+    char chunk[4096];
+    ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+    if (n <= 0) return false;
+    buffer.append(chunk, static_cast<size_t>(n));
+  }
+  return true;
+}
+
+std::string encodeSweepResult(uint32_t shard, const SweepResult & result) {
+  std::string payload(1, static_cast<char>(SWEEP_RESULT));
+  appendLE(payload, shard, 4);
+  appendLE(payload, result.failures, 4);
+  appendLE(payload, result.worstGuesses, 4);
+  appendLE(payload, result.worstAnswers.size(), 4);
+  for (WordId id : result.worstAnswers) appendLE(payload, id, 4);
+  appendLE(payload, result.histogram.size(), 2);
+  for (uint64_t count : result.histogram) appendLE(payload, count, 4);
+  return payload;
+}
+
+/*     decodeSweepResult() -> throws on a frame that's cut short or carries more bytes than it says     */
+SweepResult decodeSweepResult(const std::string & payload, uint32_t & shard) {
+  const unsigned char * data = reinterpret_cast<const unsigned char *>(payload.data());
+  auto need = [&](size_t bytes) {
+    if (payload.size() < bytes) throw std::logic_error{"Malformed sweep result"};
+  };
+
+  SweepResult result;
+  need(17);
+  shard = static_cast<uint32_t>(readLE(data + 1, 4));
+  result.failures = readLE(data + 5, 4);
+  result.worstGuesses = readLE(data + 9, 4);
+  size_t numWorst = readLE(data + 13, 4);
+  size_t pos = 17;
+  need(pos + numWorst * 4 + 2);
+  for (size_t idx = 0; idx < numWorst; ++idx, pos += 4) result.worstAnswers.push_back(static_cast<WordId>(readLE(data + pos, 4)));
+  size_t numBins = readLE(data + pos, 2);
+  pos += 2;
+  need(pos + numBins * 4);
+  for (size_t idx = 0; idx < numBins; ++idx, pos += 4) {
+    result.histogram.push_back(readLE(data + pos, 4));
+    result.games += result.histogram.back();
+  }
+  if (pos != payload.size()) throw std::logic_error{"Malformed sweep result"};
+  return result;
+}
+
+/* ---------------- coordinator ---------------- */
+
+struct SweepOptions {
+  std::string endpoint{"unix:/tmp/wordle_sweep.sock"}; // "tcp:127.0.0.1:0" picks a free port
+  size_t shardSize{64}; // answers per shard
+  std::chrono::milliseconds shardTimeout{std::chrono::seconds(30)}; // re-issue shards slower than this
+  std::chrono::milliseconds idleTimeout{std::chrono::seconds(30)}; // give up with work left and no workers
+};
+
+class SweepCoordinator {
+  public:
+    SweepCoordinator(std::vector<TierThresholds> configs, size_t numAnswers, SweepOptions options); // ctor, starts listening
+    ~SweepCoordinator(); // dtor
+    SweepCoordinator(const SweepCoordinator &) = delete;
+    SweepCoordinator & operator=(const SweepCoordinator &) = delete;
+    const std::string & endpoint() const { return endpoint_; } // actual port filled in for tcp:...:0
+    std::vector<SweepResult> run(); // one merged result per configuration, blocks until every shard is done
+    size_t reissuedShards() const { return reissued_; }
+  private:
+    struct Shard {
+      uint32_t config;
+      uint32_t begin;
+      uint32_t end;
+    };
+    struct Connection {
+      int fd;
+      std::string buffer;
+      std::optional<uint32_t> shard; // assigned, waiting for its result
+    };
+
+    std::vector<TierThresholds> configs_;
+    SweepOptions options_;
+    std::string endpoint_;
+    int listenFd_{-1};
+    std::vector<Shard> shards_;
+    size_t reissued_{0};
+};
+
+SweepCoordinator::SweepCoordinator(std::vector<TierThresholds> configs, size_t numAnswers, SweepOptions options)
+  : configs_{std::move(configs)}, options_{std::move(options)}, endpoint_{options_.endpoint} {
+  options_.shardSize = std::max<size_t>(options_.shardSize, 1);
+  for (uint32_t config = 0; config < configs_.size(); ++config) {
+    for (size_t begin = 0; begin < numAnswers; begin += options_.shardSize) {
+      shards_.push_back(Shard{config, static_cast<uint32_t>(begin), static_cast<uint32_t>(std::min(numAnswers, begin + options_.shardSize))});
+    }
+  }
+
+  SweepEndpoint parsed = parseEndpoint(endpoint_);
+  if (parsed.family == AF_UNIX) ::unlink(endpoint_.substr(5).c_str());
+  listenFd_ = ::socket(parsed.family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  int yes = 1;
+  ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+  if (listenFd_ < 0 || ::bind(listenFd_, reinterpret_cast<sockaddr *>(&parsed.address), parsed.length) != 0 || ::listen(listenFd_, 64) != 0) {
+    if (listenFd_ >= 0) ::close(listenFd_);
+    throw std::logic_error{"Could not listen on " + endpoint_};
+  }
+
+  /*     report the port the kernel picked     */
+  if (parsed.family == AF_INET) {
+    sockaddr_in bound{};
+    socklen_t length = sizeof(bound);
+    ::getsockname(listenFd_, reinterpret_cast<sockaddr *>(&bound), &length);
+    endpoint_ = endpoint_.substr(0, endpoint_.rfind(':') + 1) + std::to_string(ntohs(bound.sin_port));
+  }
+}
+
+SweepCoordinator::~SweepCoordinator() {
+  ::close(listenFd_);
+  if (endpoint_.rfind("unix:", 0) == 0) ::unlink(endpoint_.substr(5).c_str());
+}
+
+std::vector<SweepResult> SweepCoordinator::run() {
+  using Clock = std::chrono::steady_clock;
+  std::vector<std::optional<SweepResult>> results(shards_.size());
+  std::vector<Clock::time_point> issuedAt(shards_.size());
+  std::deque<uint32_t> pending;
+  for (uint32_t shard = 0; shard < shards_.size(); ++shard) pending.push_back(shard);
+  std::vector<Connection> connections;
+  size_t done = 0;
+  auto lastWorker = Clock::now();
+
+  auto drop = [&](size_t idx) {
+    Connection & conn = connections[idx];
+    if (conn.shard && !results[*conn.shard]) pending.push_front(*conn.shard);
+    ::close(conn.fd);
+    connections.erase(connections.begin() + idx);
+  };
+
+  while (done < shards_.size()) {
+    /*     hand out work to idle workers     */
+    for (Connection & conn : connections) {
+      while (!conn.shard && !pending.empty()) {
+        uint32_t shard = pending.front();
+        pending.pop_front();
+        if (results[shard]) continue;
+
+        const TierThresholds & config = configs_[shards_[shard].config];
+        std::string payload(1, static_cast<char>(SWEEP_SHARD));
+        appendLE(payload, shard, 4);
+        appendLE(payload, shards_[shard].begin, 4);
+        appendLE(payload, shards_[shard].end, 4);
+        appendLE(payload, config.endgameMax, 4);
+        appendLE(payload, config.partitionMax, 4);
+        appendLE(payload, config.endgameProbes, 4);
+        appendLE(payload, config.incrementalCounts ? 1 : 0, 4);
+        appendLE(payload, config.partitionPolicy, 4);
+        conn.shard = shard;
+        issuedAt[shard] = Clock::now();
+        if (!sendFrame(conn.fd, payload)) {
+          pending.push_front(shard);
+          conn.shard.reset();
+          break;
+        }
+      }
+    }
+
+    std::vector<pollfd> fds{pollfd{listenFd_, POLLIN, 0}};
+    for (const Connection & conn : connections) fds.push_back(pollfd{conn.fd, POLLIN, 0});
+    ::poll(fds.data(), fds.size(), 50);
+
+    if (fds[0].revents & POLLIN) {
+      int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+      if (fd >= 0) connections.push_back(Connection{fd, {}, std::nullopt});
+    }
+
+    /*     read results, drop workers that went away     */
+    for (size_t idx = fds.size() - 1; idx >= 1; --idx) {
+      if (fds[idx].revents == 0) continue;
+      Connection & conn = connections[idx - 1];
+      char chunk[4096];
+      ssize_t n = ::recv(conn.fd, chunk, sizeof(chunk), 0);
+      if (n <= 0) {
+        drop(idx - 1);
+        continue;
+      }
+      conn.buffer.append(chunk, static_cast<size_t>(n));
+
+      /*     a result that doesn't decode or doesn't fit its shard -> treat the worker as crashed     */
+      std::string payload;
+      bool broken = false;
+      while (!broken && takeFrame(conn.buffer, payload)) {
+        if (payload.empty() || payload[0] != static_cast<char>(SWEEP_RESULT)) continue;
+        uint32_t shard = 0;
+        SweepResult result;
+        try {
+          result = decodeSweepResult(payload, shard);
+        } catch (const std::logic_error &) {
+          broken = true;
+          break;
+        }
+        if (shard >= results.size() || result.games != shards_[shard].end - shards_[shard].begin) {
+          broken = true;
+          break;
+        }
+        if (!results[shard]) {
+          results[shard] = std::move(result);
+          done++;
+        }
+        if (conn.shard == shard) conn.shard.reset();
+      }
+      if (broken) drop(idx - 1);
+    }
+
+    /*     slow worker -> let another worker race it, first result wins     */
+    auto now = Clock::now();
+    for (const Connection & conn : connections) {
+      if (conn.shard && !results[*conn.shard] && now - issuedAt[*conn.shard] > options_.shardTimeout
+          && std::find(pending.begin(), pending.end(), *conn.shard) == pending.end()) {
+        pending.push_back(*conn.shard);
+        issuedAt[*conn.shard] = now;
+        reissued_++;
+      }
+    }
+
+    if (!connections.empty()) lastWorker = now;
+    else if (now - lastWorker > options_.idleTimeout) throw std::logic_error{"Sweep stalled: no workers connected."};
+  }
+
+  for (Connection & conn : connections) {
+    sendFrame(conn.fd, std::string(1, static_cast<char>(SWEEP_DONE)));
+    ::close(conn.fd);
+  }
+
+  /*     merge in shard order     */
+  std::vector<SweepResult> merged(configs_.size());
+  for (size_t shard = 0; shard < shards_.size(); ++shard) merged[shards_[shard].config].merge(*results[shard]);
+  return merged;
+}
+
+/* ---------------- worker ---------------- */
+
+struct SweepWorkerOptions {
+  size_t crashAfterShards{0}; // if set, exit without answering the n-th shard (simulates a dead worker)
+  size_t corruptShard{0}; // if set, answer the n-th shard with a truncated result (simulates a broken worker)
+};
+
+/*     runSweepWorker() -> 0 after the coordinator says done, 1 if the connection is lost, 2 on a dictionary mismatch     */
+int runSweepWorker(const std::string & endpoint, const std::string & tablesPath, SweepWorkerOptions options = {}) {
+  auto tables = std::make_shared<const SweepTables>(tablesPath);
+  if (tables->fingerprint() != currentDictionary()->index().fingerprint()) return 2;
+
+  SweepEndpoint parsed = parseEndpoint(endpoint);
+  int fd = ::socket(parsed.family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0 || ::connect(fd, reinterpret_cast<sockaddr *>(&parsed.address), parsed.length) != 0) {
+    if (fd >= 0) ::close(fd);
+    return 1;
+  }
+
+  /*     one strategy per configuration, reused across shards, all scoring from the mapped feedback table (which the scorer keeps mapped)     */
+  auto scorer = std::make_shared<const PartitionScorer>(tables->words(), std::shared_ptr<const FeedbackCode>(tables, tables->feedback()));
+  std::map<std::array<uint32_t, 5>, std::unique_ptr<TieredStrategy>> strategies;
+  std::string buffer;
+  std::string payload;
+  size_t shardsSeen = 0;
+  int status = 1;
+
+  while (recvFrame(fd, buffer, payload)) {
+    if (payload.empty()) continue;
+    if (payload[0] == static_cast<char>(SWEEP_DONE)) {
+      status = 0;
+      break;
+    }
+    if (payload[0] != static_cast<char>(SWEEP_SHARD) || payload.size() < 33) continue;
+    shardsSeen++;
+    if (options.crashAfterShards != 0 && shardsSeen >= options.crashAfterShards) break;
+
+    const unsigned char * data = reinterpret_cast<const unsigned char *>(payload.data());
+    uint32_t shard = static_cast<uint32_t>(readLE(data + 1, 4));
+    WordId begin = static_cast<WordId>(readLE(data + 5, 4));
+    WordId end = static_cast<WordId>(std::min<uint64_t>(readLE(data + 9, 4), tables->size()));
+    std::array<uint32_t, 5> key;
+    for (size_t idx = 0; idx < key.size(); ++idx) key[idx] = static_cast<uint32_t>(readLE(data + 13 + 4 * idx, 4));
+
+    auto & strategy = strategies[key];
+    if (!strategy) strategy = std::make_unique<TieredStrategy>(TierThresholds{key[0], key[1], key[2], key[3] != 0, static_cast<ScoringPolicy>(key[4])}, scorer);
+
+    SweepResult result = solveSweepRange(*strategy, [&](WordId id) { return tables->word(id); }, begin, end);
+    std::string encoded = encodeSweepResult(shard, result);
+    if (shardsSeen == options.corruptShard) encoded.resize(encoded.size() - 3);
+    if (!sendFrame(fd, encoded)) break;
+  }
+
+  ::close(fd);
+  return status;
+}
+
+
+/* ============================ C ABI ============================ */
+
+/*
+  extern "C" side of wordle.h. Handles pin a DictionaryEpoch, so a reload never changes a handle
+  under its caller; the dictionary handle also keeps every word packed by id for wordle_feedback().
+  Games run on ids: a game is a CGame header plus its candidate ids in a buffer the caller owns,
+  each step filters those ids in place by exact feedback and picks the next guess with the same
+  tiers and tie-breaks as the solver's TieredStrategy, on the ids (the opening's buckets and the
+  second guess out of each are cached on the solver). Picking allocates nothing and runs on the
+  calling thread: the endgame tier (at most endgameMax words, clamped to 32) keeps its feedback rows
+  on the stack and its memo in the game buffer. wordle_solve() and wordle_next_guess() borrow their
+  game buffer from the solver (BorrowedCGame). Nothing may throw across the boundary: errors become -1 / NULL plus wordle_last_error().
+*/
+
+struct wordle_dictionary {
+  std::shared_ptr<const DictionaryEpoch> epoch;
+  std::vector<PackedWord> packed; // by id
+};
+
+struct wordle_solver {
+  wordle_solver(std::shared_ptr<const DictionaryEpoch> dictionary, TierThresholds thresholds); // ctor, buckets every word by the opening's feedback
+
+  std::shared_ptr<const DictionaryEpoch> epoch;
+  TieredStrategy strategy; // scorer ids are the epoch's word ids
+  WordId opening{kInvalidWordId};
+  std::array<std::vector<WordId>, kNumFeedbackCodes> afterOpening; // sorted candidate ids per feedback of the opening
+  mutable std::array<std::atomic<WordId>, kNumFeedbackCodes> secondGuesses; // next guess out of each bucket, kInvalidWordId until a game needs it
+  mutable std::mutex spareGamesMutex; // guards spareGames and numGames
+  mutable std::vector<std::unique_ptr<uint64_t[]>> spareGames; // game buffers of wordle_solve() / wordle_next_guess() not in use
+  mutable size_t numGames{0}; // buffers ever allocated, spareGames is reserved for all of them
+};
+
+wordle_solver::wordle_solver(std::shared_ptr<const DictionaryEpoch> dictionary, TierThresholds thresholds)
+  : epoch{std::move(dictionary)}, strategy{thresholds, epoch->index().words()} {
+  const WordIndex & index = epoch->index();
+  opening = index.id(epoch->openingGuess());
+  for (auto & guess : secondGuesses) guess.store(kInvalidWordId);
+  if (opening == kInvalidWordId) return;
+  for (WordId id = 0; id < index.size(); ++id) afterOpening[strategy.scorer()->feedback(opening, id)].push_back(id);
+}
+
+/*     Wordle on a given epoch, without the guess count printout     */
+class EpochWordle {
+  public:
+    EpochWordle(std::string answer, std::shared_ptr<const DictionaryEpoch> dictionary) // ctor
+      : answer_{std::move(answer)}, dictionary_{std::move(dictionary)} {}
+    WordleLetterStates CharacterizeWord(const std::string& query) const {
+      ValidateWord(query, *dictionary_);
+      return decodeFeedback(computeFeedback(query, answer_));
+    }
+    const std::shared_ptr<const DictionaryEpoch> & dictionary() const { return dictionary_; }
+  private:
+    std::string answer_;
+    std::shared_ptr<const DictionaryEpoch> dictionary_;
+};
+
+/*     header of a wordle_game_size() buffer, the candidate ids follow it     */
+struct CGame {
+  const wordle_solver * solver; // the solver that started the game
+  uint64_t guessedLetters; // letter codes of every guess so far, for WORDLE_POLICY_OVERLAP
+  uint32_t count; // candidate ids after the header, unused before the first step (every word)
+  uint32_t steps;
+  EndgameMemo endgame; // scratch of the endgame tier, so picking a guess allocates nothing
+};
+
+uint32_t * cGameIds(CGame & game) {
+  return reinterpret_cast<uint32_t *>(&game + 1);
+}
+
+size_t cGameBytes(const wordle_solver & solver) {
+  return sizeof(CGame) + sizeof(uint32_t) * solver.epoch->index().size();
+}
+
+size_t cGameCandidates(const CGame & game) {
+  return game.steps == 0 ? game.solver->epoch->index().size() : game.count;
+}
+
+/*
+  BorrowedCGame: a game buffer lent by the solver for one wordle_solve() / wordle_next_guess() call.
+  A new one is allocated only when more calls run on the solver at once than ever before.
+*/
+class BorrowedCGame {
+  public:
+    explicit BorrowedCGame(const wordle_solver & solver) : solver_{solver} { // ctor
+      {
+        std::lock_guard<std::mutex> lock{solver.spareGamesMutex};
+        if (!solver.spareGames.empty()) {
+          buffer_ = std::move(solver.spareGames.back());
+          solver.spareGames.pop_back();
+          return;
+        }
+        /*     room to give it back without allocating     */
+        solver.spareGames.reserve(++solver.numGames);
+      }
+      buffer_ = std::make_unique<uint64_t[]>((cGameBytes(solver) + sizeof(uint64_t) - 1) / sizeof(uint64_t));
+    }
+    BorrowedCGame(const BorrowedCGame &) = delete;
+    BorrowedCGame & operator=(const BorrowedCGame &) = delete;
+    ~BorrowedCGame() {
+      if (!buffer_) return;
+      std::lock_guard<std::mutex> lock{solver_.spareGamesMutex};
+      solver_.spareGames.push_back(std::move(buffer_));
+    }
+
+    CGame & game() { return *reinterpret_cast<CGame *>(buffer_.get()); }
+
+  private:
+    const wordle_solver & solver_;
+    std::unique_ptr<uint64_t[]> buffer_;
+};
+
+/*     checkCGame() -> the caller's buffer as a game of "solver", throws if it's too small, misaligned or someone else's     */
+CGame & checkCGame(const wordle_solver * solver, void * game, size_t capacity, bool started) {
+  if (reinterpret_cast<uintptr_t>(game) % alignof(CGame) != 0) throw std::logic_error{"Game buffer is not aligned for uint64_t."};
+  if (capacity < cGameBytes(*solver)) throw std::logic_error{"Game buffer too small, wordle_game_size() gives " + std::to_string(cGameBytes(*solver)) + " bytes."};
+  CGame & state = *static_cast<CGame *>(game);
+  if (started && state.solver != solver) throw std::logic_error{"Game was not started by this solver."};
+  return state;
+}
+
+/*     nextCGuess() -> TieredStrategy::nextGuess() over sorted candidate ids     */
+WordId nextCGuess(const wordle_solver & solver, std::span<const uint32_t> candidates, uint64_t guessedLetters, EndgameMemo & memo) {
+  const PartitionScorer & scorer = *solver.strategy.scorer();
+  const TierThresholds & tiers = solver.strategy.thresholds();
+  if (candidates.size() == 1) return candidates.front();
+
+  /*     EndgameStrategy: the words plus the best partitioning non-candidates as first guess     */
+  if (candidates.size() <= tiers.endgameMax) {
+    std::array<ScoredGuess, 64> ranked;
+    size_t numRanked = scorer.topGuesses(candidates, std::min(tiers.endgameProbes, ranked.size()), ranked.data());
+    std::array<uint32_t, 32 + 64> rows;
+    size_t numRows = candidates.size();
+    std::copy(candidates.begin(), candidates.end(), rows.begin());
+    for (size_t idx = 0; idx < numRanked; ++idx) {
+      if (!ranked[idx].candidate) rows[numRows++] = ranked[idx].guess;
+    }
+    std::array<EndgameRow, 32 + 64> feedback;
+    for (size_t g = 0; g < numRows; ++g) {
+      for (size_t a = 0; a < candidates.size(); ++a) feedback[g][a] = scorer.feedback(rows[g], candidates[a]);
+    }
+    return rows[endgameSearch(std::span{feedback.data(), numRows}, candidates.size(), memo).second];
+  }
+
+  if (candidates.size() <= tiers.partitionMax) {
+    switch (tiers.partitionPolicy) {
+      case EXPECTED_SIZE_POLICY: {
+        ScoredGuess best;
+        return scorer.topGuesses(candidates, 1, &best) == 1 ? best.guess : candidates.front();
+      }
+      case ENTROPY_POLICY: return bestByPolicy<EntropyPolicy>(scorer, candidates, 0, scorer.size())->guess;
+      case MINIMAX_POLICY: return bestByPolicy<MinimaxPolicy>(scorer, candidates, 0, scorer.size())->guess;
+      case OVERLAP_POLICY: {
+        /*     getNextGuess(), ties to the lowest id     */
+        WordId best = candidates.front();
+        int bestOverlap = std::numeric_limits<int>::max();
+        for (WordId id : candidates) {
+          int overlap = 0;
+          for (char unit : scorer.word(id)) overlap += letterCode(unit) < kMaxLetters && (guessedLetters >> letterCode(unit) & 1);
+          if (overlap < bestOverlap) {
+            bestOverlap = overlap;
+            best = id;
+          }
+        }
+        return best;
+      }
+    }
+  }
+
+  return *positionalFrequencyPick(candidates, [&](uint32_t id) -> const std::string & { return scorer.word(id); }, solver.epoch->alphabet().size());
+}
+
+/*     stepCGame() -> narrows "game" by the feedback "guess" got, returns the next guess (the guess itself once solved)     */
+WordId stepCGame(CGame & game, WordId guess, FeedbackCode code) {
+  const wordle_solver & solver = *game.solver;
+  const PartitionScorer & scorer = *solver.strategy.scorer();
+  uint32_t * ids = cGameIds(game);
+  if (guess >= scorer.size()) throw std::logic_error{"Word id " + std::to_string(guess) + " is out of range."};
+  if (code >= kNumFeedbackCodes) throw std::logic_error{"Feedback code " + std::to_string(code) + " is out of range."};
+
+  const bool fromOpening = game.steps == 0 && guess == solver.opening;
+  if (code == kAllCorrect) {
+    ids[0] = guess;
+    game.count = 1;
+  } else if (fromOpening) {
+    const std::vector<WordId> & bucket = solver.afterOpening[code];
+    std::copy(bucket.begin(), bucket.end(), ids);
+    game.count = static_cast<uint32_t>(bucket.size());
+  } else if (game.steps == 0) {
+    game.count = 0;
+    for (WordId id = 0; id < scorer.size(); ++id) {
+      if (scorer.feedback(guess, id) == code) ids[game.count++] = id;
+    }
+  } else {
+    game.count = static_cast<uint32_t>(std::remove_if(ids, ids + game.count, [&](uint32_t id) { return scorer.feedback(guess, id) != code; }) - ids);
+  }
+  game.steps++;
+  for (char unit : scorer.word(guess)) {
+    if (letterCode(unit) < kMaxLetters) game.guessedLetters |= uint64_t{1} << letterCode(unit);
+  }
+  if (game.count == 0) throw std::logic_error{"No word matches the feedback so far."};
+
+  std::span<const uint32_t> candidates{ids, game.count};
+  if (!fromOpening || code == kAllCorrect) return nextCGuess(solver, candidates, game.guessedLetters, game.endgame);
+  WordId second = solver.secondGuesses[code].load(std::memory_order_relaxed);
+  if (second == kInvalidWordId) {
+    second = nextCGuess(solver, candidates, game.guessedLetters, game.endgame);
+    solver.secondGuesses[code].store(second, std::memory_order_relaxed);
+  }
+  return second;
+}
+
+/*     startCGame() -> fresh game in "game", returns the opening     */
+WordId startCGame(const wordle_solver & solver, CGame & game) {
+  if (solver.opening == kInvalidWordId) throw std::logic_error{"No guess left in the dictionary."};
+  /*     default-initialized, the endgame memo is cleared by each search     */
+  CGame & fresh = *::new (static_cast<void *>(&game)) CGame;
+  fresh.solver = &solver;
+  fresh.guessedLetters = 0;
+  fresh.count = 0;
+  fresh.steps = 0;
+  return solver.opening;
+}
+
+thread_local std::string lastCError;
+
+/*     cCall() -> runs fn, turning exceptions into "onError" + wordle_last_error()     */
+template <class Fn, class Result>
+Result cCall(Fn fn, Result onError) {
+  try {
+    return fn();
+  } catch (const std::exception & error) {
+    lastCError = error.what();
+  } catch (...) {
+    lastCError = "unknown error";
+  }
+  return onError;
+}
+
+/*     checkArgument() -> throws for a NULL handle, or a NULL buffer the call would touch ("count" > 0)     */
+void checkArgument(const void * argument, const char * name, size_t count = 1) {
+  if (argument == nullptr && count > 0) throw std::logic_error{std::string{name} + " is NULL."};
+}
+
+void checkIds(const wordle_dictionary * dictionary, const uint32_t * ids, size_t count) {
+  for (size_t idx = 0; idx < count; ++idx) {
+    if (ids[idx] >= dictionary->packed.size()) throw std::logic_error{"Word id " + std::to_string(ids[idx]) + " is out of range."};
+  }
+}
+
+wordle_dictionary * makeCDictionary(std::shared_ptr<const DictionaryEpoch> epoch) {
+  auto dictionary = std::make_unique<wordle_dictionary>();
+  dictionary->epoch = std::move(epoch);
+  dictionary->packed.reserve(dictionary->epoch->index().size());
+  for (const std::string & word : dictionary->epoch->index().words()) dictionary->packed.push_back(packWord(word));
+  return dictionary.release();
+}
+
+extern "C" {
+
+const char * wordle_last_error(void) {
+  return lastCError.c_str();
+}
+
+wordle_dictionary * wordle_dictionary_load(const char * path) {
+  return cCall([&]() {
+    Alphabet letters;
+    WordBuckets buckets = loadWordBuckets(path, letters);
+    const std::vector<std::string> & words = buckets[5];
+    if (words.empty()) throw std::logic_error{std::string{"No 5-letter words in "} + path};
+    return makeCDictionary(std::make_shared<const DictionaryEpoch>(std::unordered_set<std::string>(words.begin(), words.end()), 0, letters));
+  }, static_cast<wordle_dictionary *>(nullptr));
+}
+
+wordle_dictionary * wordle_dictionary_current(void) {
+  return cCall([]() { return makeCDictionary(currentDictionary()); }, static_cast<wordle_dictionary *>(nullptr));
+}
+
+void wordle_dictionary_free(wordle_dictionary * dictionary) {
+  delete dictionary;
+}
+
+uint32_t wordle_dictionary_size(const wordle_dictionary * dictionary) {
+  return cCall([&]() {
+    checkArgument(dictionary, "dictionary");
+    return static_cast<uint32_t>(dictionary->packed.size());
+  }, uint32_t{0});
+}
+
+uint32_t wordle_dictionary_id(const wordle_dictionary * dictionary, const char * word) {
+  return cCall([&]() {
+    checkArgument(dictionary, "dictionary");
+    checkArgument(word, "word");
+    return dictionary->epoch->index().id(encodeWord(word, dictionary->epoch->alphabet()));
+  }, kInvalidWordId);
+}
+
+int wordle_dictionary_word(const wordle_dictionary * dictionary, uint32_t id, char * out, size_t capacity) {
+  return cCall([&]() {
+    checkArgument(dictionary, "dictionary");
+    checkArgument(out, "out");
+    checkIds(dictionary, &id, 1);
+    std::string word = decodeWord(dictionary->epoch->index().word(id), dictionary->epoch->alphabet());
+    if (word.size() >= capacity) throw std::logic_error{"Buffer too small for word " + word};
+    std::memcpy(out, word.c_str(), word.size() + 1);
+    return 0;
+  }, -1);
+}
+
+int wordle_feedback(const wordle_dictionary * dictionary, const uint32_t * guesses, const uint32_t * answers, size_t count, uint8_t * feedback) {
+  return cCall([&]() {
+    checkArgument(dictionary, "dictionary");
+    checkArgument(guesses, "guesses", count);
+    checkArgument(answers, "answers", count);
+    checkArgument(feedback, "feedback", count);
+    checkIds(dictionary, guesses, count);
+    checkIds(dictionary, answers, count);
+    const PackedWord * packed = dictionary->packed.data();
+    for (size_t idx = 0; idx < count; ++idx) feedback[idx] = packedFeedback(packed[guesses[idx]], packed[answers[idx]]);
+    return 0;
+  }, -1);
+}
+
+wordle_solver * wordle_solver_create(const wordle_dictionary * dictionary, int policy) {
+  return cCall([&]() {
+    checkArgument(dictionary, "dictionary");
+    if (policy < 0 || policy > static_cast<int>(OVERLAP_POLICY)) throw std::logic_error{"Unknown scoring policy " + std::to_string(policy)};
+    TierThresholds thresholds;
+    thresholds.partitionPolicy = static_cast<ScoringPolicy>(policy);
+    return new wordle_solver{dictionary->epoch, thresholds};
+  }, static_cast<wordle_solver *>(nullptr));
+}
+
+void wordle_solver_free(wordle_solver * solver) {
+  delete solver;
+}
+
+size_t wordle_game_size(const wordle_solver * solver) {
+  return cCall([&]() {
+    checkArgument(solver, "solver");
+    return cGameBytes(*solver);
+  }, size_t{0});
+}
+
+int wordle_game_start(const wordle_solver * solver, void * game, size_t capacity, uint32_t * next) {
+  return cCall([&]() {
+    checkArgument(solver, "solver");
+    checkArgument(game, "game");
+    checkArgument(next, "next");
+    *next = startCGame(*solver, checkCGame(solver, game, capacity, false));
+    return 0;
+  }, -1);
+}
+
+int wordle_game_step(const wordle_solver * solver, void * game, size_t capacity, uint32_t guess, uint8_t feedback, uint32_t * next) {
+  return cCall([&]() {
+    checkArgument(solver, "solver");
+    checkArgument(game, "game");
+    checkArgument(next, "next");
+    *next = stepCGame(checkCGame(solver, game, capacity, true), guess, feedback);
+    return 0;
+  }, -1);
+}
+
+int wordle_solve(const wordle_solver * solver, const uint32_t * answers, size_t count, uint32_t * guesses_used, uint32_t * solved) {
+  return cCall([&]() {
+    checkArgument(solver, "solver");
+    checkArgument(answers, "answers", count);
+    checkArgument(guesses_used, "guesses_used", count);
+    checkArgument(solved, "solved", count);
+    if (count == 0) return 0;
+    const PartitionScorer & scorer = *solver->strategy.scorer();
+
+    /*     one game buffer for the whole batch, every game reuses it     */
+    BorrowedCGame borrowed{*solver};
+    CGame & game = borrowed.game();
+    for (size_t idx = 0; idx < count; ++idx) {
+      if (answers[idx] >= scorer.size()) throw std::logic_error{"Word id " + std::to_string(answers[idx]) + " is out of range."};
+      WordId guess = startCGame(*solver, game);
+      uint32_t played = 0;
+      bool lastCorrect = false;
+
+      /*     same rounds as solveGame(): play until one candidate is left     */
+      for (size_t before = cGameCandidates(game); before > 1;) {
+        FeedbackCode code = scorer.feedback(guess, answers[idx]);
+        guess = stepCGame(game, guess, code);
+        played++;
+        lastCorrect = code == kAllCorrect;
+        if (game.count >= before) throw std::logic_error{"Game " + std::to_string(idx) + ": guess did not narrow the candidates."};
+        before = game.count;
+      }
+      solved[idx] = guess;
+      guesses_used[idx] = played + (lastCorrect ? 0 : 1);
+    }
+    return 0;
+  }, -1);
+}
+
+int wordle_next_guess(const wordle_solver * solver, const uint32_t * guesses, const uint8_t * feedback, size_t steps, uint32_t * next) {
+  return cCall([&]() {
+    checkArgument(solver, "solver");
+    checkArgument(guesses, "guesses", steps);
+    checkArgument(feedback, "feedback", steps);
+    checkArgument(next, "next");
+    BorrowedCGame borrowed{*solver};
+    CGame & game = borrowed.game();
+    WordId guess = startCGame(*solver, game);
+    for (size_t step = 0; step < steps; ++step) {
+      guess = stepCGame(game, guesses[step], feedback[step]);
+      if (feedback[step] == kAllCorrect) break;
+    }
+    *next = guess;
+    return 0;
+  }, -1);
+}
+
+} // extern "C"
+
+#ifndef WORDLE_LIBRARY
 using Catch::Matchers::Equals;
 
 
@@ -839,15 +4498,19 @@ using Catch::Matchers::Equals;
 /*==========================*/
 /* WORD GENERATING FUNCTION */
 /*==========================*/
-std::string getRandomWord (const std::unordered_set<std::string> & fiveLetterWords) {
-  std::random_device rd;
-  std::mt19937 rng(rd());
-  auto it = fiveLetterWords.begin();
-  std::advance(it, rng() % fiveLetterWords.size());
-  return *it;
+/*     picks from the sorted dictionary with a caller-seeded rng, so runs are reproducible     */
+std::string getRandomWord (const WordIndex & index, std::mt19937 & rng) {
+  return index.word(static_cast<WordId>(rng() % index.size()));
+}
+
+/*     Catch's --rng-seed if given, otherwise a fresh random seed (printed so the run can be repeated)     */
+unsigned int testSeed() {
+  unsigned int seed = Catch::rngSeed();
+  if (seed == 0) seed = std::random_device{}();
+  std::cout << "Seed: " << seed << std::endl;
+  return seed;
 }
 
-std::unordered_set<std::string>fiveLetterWords = GetAllValidWords();
 
 
 
@@ -866,13 +4529,1234 @@ TEST_CASE("WordleTest_pross", "[given_test]") {
 /*============= =====*/
 int numberOfTests = 380; // max 380 tests at once
 TEST_CASE("WordleTest_", "[given_test]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+
+  /*     WORDLE_TRACE_OUT=<file> records every game for offline replay     */
+  std::unique_ptr<TraceWriter> writer;
+  if (const char * tracePath = std::getenv("WORDLE_TRACE_OUT")) {
+    writer = std::make_unique<TraceWriter>(tracePath, index);
+  }
+
   for (int i = 0; i < numberOfTests; ++i) {
-    std::string randomWord = getRandomWord(fiveLetterWords);
+    std::string randomWord = getRandomWord(index, rng);
     Wordle wordle{randomWord};
-    REQUIRE_THAT(SolveWordle(wordle), Equals(randomWord));
+    GameTrace trace;
+    trace.answer = index.id(randomWord);
+    REQUIRE_THAT(SolveWordle(wordle, writer ? &trace : nullptr), Equals(randomWord));
+    if (writer) writer->append(trace);
+  }
+}
+
+/*===============*/
+/* GAME TRACES   */
+/*===============*/
+TEST_CASE("FeedbackCode_roundtrip", "[trace]") {
+  for (size_t code = 0; code < kNumFeedbackCodes; ++code) {
+    REQUIRE(encodeFeedback(decodeFeedback(static_cast<FeedbackCode>(code))) == code);
+  }
+  WordleLetterStates allCorrect;
+  allCorrect.fill(CORRECT);
+  REQUIRE(encodeFeedback(allCorrect) == kAllCorrect);
+}
+
+TEST_CASE("GameTrace_recordAndReplay", "[trace]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  const std::string path = "wordle_trace_test.bin";
+  std::remove(path.c_str());
+  std::mt19937 rng(testSeed());
+
+  std::vector<std::string> answers;
+  for (int i = 0; i < 16; ++i) answers.push_back(getRandomWord(index, rng));
+
+  /*     record from several threads into one file     */
+  {
+    TraceWriter writer{path, index};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t) {
+      threads.emplace_back([&, t]() {
+        for (size_t i = t; i < answers.size(); i += 4) {
+          GameTrace trace;
+          trace.answer = index.id(answers[i]);
+          Wordle wordle{answers[i]};
+          SolveWordle(wordle, &trace);
+          writer.append(trace);
+        }
+      });
+    }
+    for (auto & thread : threads) thread.join();
+  }
+
+  std::vector<GameTrace> games = readTrace(path, index);
+  REQUIRE(games.size() == answers.size());
+  for (const GameTrace & game : games) {
+    REQUIRE(game.result == game.answer);
+    REQUIRE(!game.steps.empty());
+    REQUIRE(game.steps.front().guess == index.id("slate"));
+    REQUIRE(game.steps.back().candidatesAfter >= 1);
+  }
+
+  ReplayReport report = replayTrace(games, index);
+  std::cout << report;
+  REQUIRE(report.games == games.size());
+  REQUIRE(report.failedGames == 0);
+  REQUIRE(report.divergences.empty());
+
+  /*     a tampered guess is reported as a divergence at that step     */
+  games[0].steps[0].guess = (games[0].steps[0].guess + 1) % index.size();
+  report = replayTrace({games[0]}, index);
+  REQUIRE(report.divergences.size() == 1);
+  REQUIRE(report.divergences[0].second == 0);
+
+  /*     ids past the dictionary are rejected on read, and fail the game if built in memory     */
+  GameTrace unknown = games[0];
+  unknown.answer = kInvalidWordId;
+  report = replayTrace({unknown}, index);
+  REQUIRE(report.failedGames == 1);
+
+  for (size_t offset : {size_t{0}, size_t{10}}) { // the first game's answer, its first step's guess
+    std::string bytes;
+    {
+      std::ifstream in(path, std::ios::binary);
+      bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const std::string corruptPath = "wordle_trace_corrupt.bin";
+    std::memset(bytes.data() + kTraceHeaderBytes + offset, 0xff, 4);
+    std::ofstream(corruptPath, std::ios::binary) << bytes;
+    REQUIRE_THROWS_WITH(readTrace(corruptPath, index), Catch::Matchers::Contains("out of range"));
+    std::remove(corruptPath.c_str());
+  }
+
+  /*     a game too long for the u16 step count is refused instead of written with a wrapped count     */
+  {
+    TraceWriter writer{path, index};
+    GameTrace endless = games[1];
+    endless.dictionary = index.fingerprint();
+    endless.steps.resize(size_t{std::numeric_limits<uint16_t>::max()} + 1, endless.steps.back());
+    REQUIRE_THROWS_WITH(writer.append(endless), Catch::Matchers::Contains("steps"));
+    endless.steps.resize(std::numeric_limits<uint16_t>::max());
+    REQUIRE_NOTHROW(writer.append(endless));
+  }
+  games = readTrace(path, index);
+  REQUIRE(games.size() == answers.size() + 1);
+  REQUIRE(games.back().steps.size() == std::numeric_limits<uint16_t>::max());
+
+  std::remove(path.c_str());
+}
+
+/*==================*/
+/* GUESS STRATEGIES */
+/*==================*/
+TEST_CASE("ComputeFeedback_matchesCharacterizeWord", "[strategy]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+
+  /*     duplicate letters on either side     */
+  REQUIRE(computeFeedback("speed", "abide") == encodeFeedback({NOT_CONTAINED, NOT_CONTAINED, CONTAINED, NOT_CONTAINED, CONTAINED}));
+  REQUIRE(computeFeedback("eerie", "speed") == encodeFeedback({CONTAINED, CONTAINED, NOT_CONTAINED, NOT_CONTAINED, NOT_CONTAINED}));
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string guess = getRandomWord(index, rng);
+    std::string answer = index.word(static_cast<WordId>(rng() % index.size()));
+    Wordle oracle{answer};
+    REQUIRE(computeFeedback(guess, answer) == encodeFeedback(oracle.CharacterizeWord(guess)));
+  }
+}
+
+TEST_CASE("EndgameStrategy_totalGuesses", "[strategy]") {
+  std::string best;
+
+  /*     any first guess tells the other two apart -> 1 + 2 + 2     */
+  REQUIRE(endgameTotalGuesses({"plate", "slate", "state"}, &best) == 5);
+
+  /*     disjoint letters: first guess can't separate the other two -> 1 + 2 + 3     */
+  REQUIRE(endgameTotalGuesses({"abcde", "fghij", "klmno"}, &best) == 6);
+  REQUIRE(best == "abcde");
+
+  REQUIRE(endgameTotalGuesses({"crane"}, &best) == 1);
+  REQUIRE(best == "crane");
+}
+
+TEST_CASE("TieredStrategy_routesBySize", "[strategy]") {
+  SolverState state;
+  state.possibleAnswers = {"fight", "light", "might", "night", "right", "sight"};
+  const std::vector<std::string> allowed = currentDictionary()->index().words();
+  auto scorer = std::make_shared<const PartitionScorer>(allowed);
+
+  TieredStrategy endgame{TierThresholds{10, 100}, allowed};
+  TieredStrategy partition{TierThresholds{2, 100}, allowed};
+  TieredStrategy frequency{TierThresholds{2, 4}, allowed};
+  REQUIRE(endgame.nextGuess(state) == EndgameStrategy{scorer}.nextGuess(state));
+  REQUIRE(partition.nextGuess(state) == PartitionStrategy{scorer}.nextGuess(state));
+  REQUIRE(frequency.nextGuess(state) == PositionalFrequencyStrategy{}.nextGuess(state));
+  REQUIRE(state.possibleAnswers.count(frequency.nextGuess(state)) == 1);
+}
+
+TEST_CASE("PartitionScorer_probeSplitsTrapFamily", "[strategy]") {
+  const std::vector<std::string> trap = {"fight", "light", "might", "night", "right", "sight"};
+  std::vector<std::string> allowed = trap;
+  allowed.push_back("flmrs"); // not an answer, but puts each family member in its own bucket
+
+  PartitionScorer scorer{allowed};
+  std::vector<ScoredGuess> top = scorer.topGuesses(trap, 2);
+  REQUIRE(top.size() == 2);
+  REQUIRE(scorer.word(top[0].guess) == "flmrs");
+  REQUIRE(top[0].score == 6);
+  REQUIRE(!top[0].candidate);
+  REQUIRE(top[1].candidate);
+
+  SolverState state;
+  state.possibleAnswers = {trap.begin(), trap.end()};
+  REQUIRE(PartitionStrategy{std::make_shared<const PartitionScorer>(allowed)}.nextGuess(state) == "flmrs");
+
+  /*     candidates only: 1 + 2 + ... + 6, with the probe: 6 + 6     */
+  std::string best;
+  REQUIRE(endgameTotalGuesses(trap, &best) == 21);
+  REQUIRE(endgameTotalGuesses(trap, &best, {"flmrs"}) == 12);
+  REQUIRE(best == "flmrs");
+}
+
+TEST_CASE("PartitionStrategy_probesAlwaysNarrow", "[strategy]") {
+  /*     every word over {a,b,c,d}: probes split by letter counts the letter filter alone can't express     */
+  std::vector<std::string> words;
+  for (size_t code = 0; code < 1024; ++code) {
+    std::string word;
+    for (size_t rest = code, idx = 0; idx < 5; ++idx, rest /= 4) word.insert(word.begin(), static_cast<char>('a' + rest % 4));
+    words.push_back(word);
+  }
+  auto epoch = std::make_shared<const DictionaryEpoch>(std::unordered_set<std::string>(words.begin(), words.end()), 0);
+  auto scorer = std::make_shared<const PartitionScorer>(words);
+  TieredStrategy partition{TierThresholds{0, 1000}, scorer};
+  TieredStrategy incremental{TierThresholds{0, 1000, 16, true}, scorer};
+  AnytimeStrategy anytime{scorer, AnytimeBudget{size_t{1} << 16, std::chrono::seconds{60}, 64, 16, 3}};
+
+  /*     "babcd" left {babcd, cabcd, dabcd} after "aabcd", and the probe "abbcc" then repeated forever     */
+  for (const GuessStrategy * strategy : std::initializer_list<const GuessStrategy *>{&partition, &incremental, &anytime}) {
+    for (const std::string & answer : words) {
+      GameTrace trace;
+      REQUIRE(solveGame(EpochWordle{answer, epoch}, *strategy, &trace) == answer);
+      REQUIRE(guessCount(trace) <= 8);
+    }
+  }
+}
+
+TEST_CASE("PartitionScorer_matchesFullScoring", "[strategy]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  std::vector<std::string> candidates;
+  for (int i = 0; i < 200; ++i) candidates.push_back(getRandomWord(index, rng));
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  /*     no cut-off, no threads     */
+  std::vector<ScoredGuess> full;
+  for (WordId g = 0; g < index.size(); ++g) {
+    std::array<uint64_t, kNumFeedbackCodes> buckets{};
+    for (const std::string & answer : candidates) buckets[computeFeedback(index.word(g), answer)]++;
+    uint64_t score = 0;
+    for (uint64_t count : buckets) score += count * count;
+    bool candidate = std::binary_search(candidates.begin(), candidates.end(), index.word(g));
+    full.push_back(ScoredGuess{score, candidate, g});
+  }
+  std::sort(full.begin(), full.end());
+
+  PartitionScorer serial{index.words(), 1};
+  PartitionScorer parallel{index.words(), 4};
+  std::vector<ScoredGuess> fromSerial = serial.topGuesses(candidates, 5);
+  std::vector<ScoredGuess> fromParallel = parallel.topGuesses(candidates, 5);
+  REQUIRE(fromSerial.size() == 5);
+  for (size_t idx = 0; idx < 5; ++idx) {
+    REQUIRE(fromSerial[idx].guess == full[idx].guess);
+    REQUIRE(fromSerial[idx].score == full[idx].score);
+    REQUIRE(fromParallel[idx].guess == full[idx].guess);
+  }
+}
+
+/*     calibration: ./wordle "[benchmark]" prints guesses + time per threshold setting     */
+TEST_CASE("TieredStrategy_calibrate", "[.][benchmark]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  std::vector<std::string> answers;
+  for (int i = 0; i < 200; ++i) answers.push_back(getRandomWord(index, rng));
+
+  auto run = [&](const std::string & name, const GuessStrategy & strategy) {
+    size_t total = 0;
+    size_t worst = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string & answer : answers) {
+      Wordle wordle{answer};
+      GameTrace trace;
+      REQUIRE(SolveWordle(wordle, strategy, &trace) == answer);
+      total += guessCount(trace);
+      worst = std::max(worst, guessCount(trace));
+    }
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "BENCH " << name << ": mean " << double(total) / answers.size() << " guesses, worst " << worst
+              << ", " << ms << " ms" << std::endl;
+  };
+
+  run("overlap", OverlapStrategy{});
+  for (size_t endgameMax : {0, 8, 20}) {
+    for (size_t partitionMax : {0, 100, 1000, 5000}) {
+      run("tiered endgame<=" + std::to_string(endgameMax) + " partition<=" + std::to_string(partitionMax),
+          TieredStrategy{TierThresholds{endgameMax, partitionMax}, index.words()});
+    }
+  }
+  run("tiered incremental counts", TieredStrategy{TierThresholds{20, 100, 16, true}, index.words()});
+  run("tiered incremental counts partition<=1000", TieredStrategy{TierThresholds{20, 1000, 16, true}, index.words()});
+  for (ScoringPolicy policy : {EXPECTED_SIZE_POLICY, ENTROPY_POLICY, MINIMAX_POLICY, OVERLAP_POLICY}) {
+    run("tiered partition<=1000 policy " + std::to_string(policy), TieredStrategy{TierThresholds{20, 1000, 16, false, policy}, index.words()});
+  }
+}
+
+TEST_CASE("PartitionCounts_matchesScorer", "[strategy]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  auto scorer = std::make_shared<const PartitionScorer>(index.words());
+
+  std::vector<std::string> words;
+  for (int i = 0; i < 300; ++i) words.push_back(getRandomWord(index, rng));
+  std::sort(words.begin(), words.end());
+  words.erase(std::unique(words.begin(), words.end()), words.end());
+
+  const size_t bytesBefore = PartitionCounts::bytesInUse();
+  PartitionCounts counts{scorer, *scorer->ids(words)};
+  REQUIRE(PartitionCounts::bytesInUse() == bytesBefore + scorer->size() * kNumFeedbackCodes * sizeof(uint16_t));
+  std::vector<std::vector<std::string>> history{words};
+  std::vector<size_t> marks{counts.checkpoint()};
+
+  /*     uncounted until asked; then a few words leave (subtract), most of them (stale, rebuilt when asked), a few again     */
+  REQUIRE(counts.stale());
+  for (size_t keepPercent : {90, 95, 20, 90}) {
+    std::vector<std::string> kept;
+    for (const std::string & word : history.back()) {
+      if (rng() % 100 < keepPercent) kept.push_back(word);
+    }
+    if (kept.empty()) kept.push_back(history.back().front());
+    const bool wasStale = counts.stale();
+    counts.retain(*scorer->ids(kept));
+    history.push_back(kept);
+    marks.push_back(counts.checkpoint());
+    REQUIRE(counts.shrinkingSlowly() == (keepPercent != 20));
+    REQUIRE(counts.stale() == (wasStale || keepPercent == 20));
+
+    std::vector<ScoredGuess> expected = scorer->topGuesses(kept, 3);
+    std::vector<ScoredGuess> found = counts.topGuesses(3);
+    REQUIRE(found.size() == expected.size());
+    for (size_t idx = 0; idx < found.size(); ++idx) {
+      REQUIRE(found[idx].guess == expected[idx].guess);
+      REQUIRE(found[idx].score == expected[idx].score);
+      REQUIRE(found[idx].candidate == expected[idx].candidate);
+    }
+  }
+  REQUIRE(counts.subtractions() == 2);
+  REQUIRE(counts.rebuilds() == 2);
+
+  /*     back to an earlier round     */
+  counts.rollback(marks[1]);
+  REQUIRE(counts.candidates() == *scorer->ids(history[1]));
+  REQUIRE(counts.topGuesses(1).front().guess == scorer->topGuesses(history[1], 1).front().guess);
+  counts.rollback(marks[0]);
+  REQUIRE(counts.candidates() == *scorer->ids(words));
+  REQUIRE(counts.topGuesses(1).front().score == scorer->topGuesses(words, 1).front().score);
+
+  /*     a retain() that adds words drops the log: older checkpoints throw instead of leaving the counts wrong     */
+  REQUIRE_THROWS_AS(counts.rollback(counts.checkpoint() + 1), std::logic_error);
+  counts.retain(*scorer->ids(history[2]));
+  const size_t beforeGrow = counts.checkpoint();
+  counts.retain(*scorer->ids(history[1]));
+  REQUIRE_THROWS_AS(counts.rollback(marks[0]), std::logic_error);
+  REQUIRE_THROWS_AS(counts.rollback(beforeGrow), std::logic_error);
+  REQUIRE(counts.candidates() == *scorer->ids(history[1]));
+  REQUIRE(counts.topGuesses(1).front().score == scorer->topGuesses(history[1], 1).front().score);
+  counts.rollback(counts.checkpoint());
+
+  /*     copies of a game state don't share its counts     */
+  SolverState state;
+  state.possibleAnswers = {words.begin(), words.end()};
+  TieredStrategy incremental{TierThresholds{0, 1000, 16, true}, scorer};
+  incremental.nextGuess(state);
+  REQUIRE(state.partitionCounts.counts != nullptr);
+  SolverState copy = state;
+  REQUIRE(copy.partitionCounts.counts == nullptr);
+  copy = state;
+  REQUIRE(copy.partitionCounts.counts == nullptr);
+  SolverState moved = std::move(state);
+  REQUIRE(moved.partitionCounts.counts != nullptr);
+}
+
+TEST_CASE("PartitionCounts_sameGamesAsRescan", "[strategy]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  TieredStrategy rescan{TierThresholds{20, 1000, 16, false}, index.words()};
+  TieredStrategy incremental{TierThresholds{20, 1000, 16, true}, index.words()};
+
+  for (int i = 0; i < 20; ++i) {
+    std::string answer = getRandomWord(index, rng);
+    GameTrace withRescan;
+    GameTrace withCounts;
+    Wordle first{answer};
+    Wordle second{answer};
+    REQUIRE(SolveWordle(first, rescan, &withRescan) == answer);
+    REQUIRE(SolveWordle(second, incremental, &withCounts) == answer);
+    REQUIRE(withRescan.steps.size() == withCounts.steps.size());
+    for (size_t step = 0; step < withRescan.steps.size(); ++step) {
+      REQUIRE(withRescan.steps[step].guess == withCounts.steps[step].guess);
+    }
+  }
+}
+
+/*     incremental counts against a full rescan, per shrink rate and over real games: ./wordle "[benchmark]"     */
+TEST_CASE("PartitionCounts_benchmark", "[.][benchmark]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  auto scorer = std::make_shared<const PartitionScorer>(index.words());
+  auto micros = [](std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  /*     one elimination trajectory per rate (a weak guesser, or search walking down a branch), ranked both ways     */
+  for (size_t leavePercent : {2, 5, 10, 20, 50, 90}) {
+    std::vector<std::vector<std::string>> rounds{index.words()};
+    while (rounds.back().size() > 50 && rounds.size() < 200) {
+      std::vector<std::string> kept;
+      for (const std::string & word : rounds.back()) {
+        if (rng() % 100 >= leavePercent) kept.push_back(word);
+      }
+      if (kept.empty()) break;
+      rounds.push_back(std::move(kept));
+    }
+
+    SolverState state;
+    std::vector<uint32_t> rescanPicks;
+    std::vector<uint32_t> countsPicks;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto & words : rounds) rescanPicks.push_back(rankGuesses(state, words, scorer, 1, false).front().guess);
+    auto rescanUs = micros(start);
+    start = std::chrono::steady_clock::now();
+    for (const auto & words : rounds) countsPicks.push_back(rankGuesses(state, words, scorer, 1, true).front().guess);
+    auto countsUs = micros(start);
+    REQUIRE(countsPicks == rescanPicks);
+    std::cout << "BENCH partition counts " << leavePercent << "% leave per round, " << rounds.size() << " rounds: rescan "
+              << rescanUs << " us, incremental " << countsUs << " us (" << state.partitionCounts.counts->subtractions() << " subtractions, "
+              << state.partitionCounts.counts->rebuilds() << " rebuilds)" << std::endl;
+  }
+
+  /*     normal play shrinks too fast to subtract: incremental has to match the rescan, not lose 2x to rebuilds     */
+  const unsigned int seed = testSeed();
+  for (bool incremental : {false, true}) {
+    TieredStrategy strategy{TierThresholds{20, 1000, 16, incremental}, index.words()};
+    std::mt19937 answers(seed);
+    size_t guesses = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 200; ++i) {
+      GameTrace trace;
+      Wordle wordle{getRandomWord(index, answers)};
+      SolveWordle(wordle, strategy, &trace);
+      guesses += guessCount(trace);
+    }
+    std::cout << "BENCH partition counts games, incremental " << incremental << ": " << guesses << " guesses, " << micros(start) << " us" << std::endl;
+  }
+}
+
+TEST_CASE("ScoringPolicy_kernels", "[strategy]") {
+  FeedbackBuckets buckets{};
+  buckets[0] = 4;
+  buckets[1] = 2;
+  buckets[242] = 1;
+  REQUIRE(ExpectedSizePolicy::reduce(buckets) == 21);
+  REQUIRE(EntropyPolicy::reduce(buckets) == Approx(10.0));
+  REQUIRE(MinimaxPolicy::reduce(buckets) == std::make_pair(uint32_t{4}, uint64_t{21}));
+
+  /*     the generic loop agrees with the cut-off scorer, and overlap is getNextGuess() with ties to the smallest word     */
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  auto scorer = std::make_shared<const PartitionScorer>(index.words());
+  std::mt19937 rng(testSeed());
+  SolverState state;
+  for (int i = 0; i < 150; ++i) state.possibleAnswers.insert(getRandomWord(index, rng));
+  state.guessedLetters = {'s', 'l', 'a', 't', 'e'};
+  REQUIRE(PolicyStrategy<ExpectedSizePolicy>{scorer}.nextGuess(state) == PartitionStrategy{scorer}.nextGuess(state));
+  auto noGuesses = std::make_shared<const PartitionScorer>(std::vector<std::string>{});
+  const std::string smallest = *std::min_element(state.possibleAnswers.begin(), state.possibleAnswers.end());
+  REQUIRE(PolicyStrategy<EntropyPolicy>{noGuesses}.nextGuess(state) == smallest);
+  REQUIRE(PartitionStrategy{noGuesses}.nextGuess(state) == smallest);
+  const std::string overlapPick = makePolicyStrategy(OVERLAP_POLICY, scorer)->nextGuess(state);
+  const int fewest = calculateLetterOverlap(getNextGuess(state.possibleAnswers, state.guessedLetters), state.guessedLetters);
+  REQUIRE(calculateLetterOverlap(overlapPick, state.guessedLetters) == fewest);
+  for (const std::string & word : state.possibleAnswers) {
+    if (calculateLetterOverlap(word, state.guessedLetters) == fewest) REQUIRE(overlapPick <= word);
+  }
+
+  for (ScoringPolicy policy : {EXPECTED_SIZE_POLICY, ENTROPY_POLICY, MINIMAX_POLICY, OVERLAP_POLICY}) {
+    TieredStrategy strategy{TierThresholds{20, 1000, 16, false, policy}, index.words()};
+    std::string answer = getRandomWord(index, rng);
+    Wordle wordle{answer};
+    REQUIRE(SolveWordle(wordle, strategy) == answer);
+  }
+}
+
+/*====================*/
+/* ADVERSARIAL ORACLE */
+/*====================*/
+TEST_CASE("AdversarialWordle_staysConsistent", "[adversary]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+
+  for (AdversaryMode mode : {LARGEST_BUCKET, HARDEST_BUCKET}) {
+    AdversarialWordle adversary{index.words(), mode};
+    GameTrace trace;
+    std::string solved = solveGame(adversary, adversary.dictionary()->strategy(), &trace);
+
+    /*     one word left, and it explains every answer the adversary gave     */
+    REQUIRE(adversary.remaining() == 1);
+    REQUIRE(solved == adversary.answer());
+    for (const TraceStep & step : trace.steps) {
+      REQUIRE(computeFeedback(index.word(step.guess), solved) == step.feedback);
+    }
+    REQUIRE(trace.steps.front().candidatesAfter >= trace.steps.front().candidatesBefore / kNumFeedbackCodes);
+  }
+}
+
+TEST_CASE("AdversarialWordle_keepsLargestBucket", "[adversary]") {
+  /*     "slate" splits these into {plate, elate} (same pattern) and {crane}     */
+  AdversarialWordle adversary{{"plate", "elate", "crane"}};
+  WordleLetterStates states = adversary.CharacterizeWord("slate");
+  REQUIRE(adversary.remaining() == 2);
+  REQUIRE(encodeFeedback(states) == computeFeedback("slate", "plate"));
+  REQUIRE(adversary.guesses() == 1);
+
+  /*     HARDEST_BUCKET scores buckets by scorer id, so every candidate must be one of its guesses     */
+  auto plateOnly = std::make_shared<const PartitionScorer>(std::vector<std::string>{"plate"});
+  REQUIRE_THROWS_AS((AdversarialWordle{{"plate", "crane"}, HARDEST_BUCKET, plateOnly}), std::logic_error);
+}
+
+/*     worst case per strategy: ./wordle "[benchmark]"     */
+TEST_CASE("AdversarialWordle_benchmark", "[.][benchmark]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  auto run = [&](const std::string & name, const GuessStrategy & strategy, AdversaryMode mode) {
+    AdversarialWordle adversary{index.words(), mode};
+    GameTrace trace;
+    auto start = std::chrono::steady_clock::now();
+    solveGame(adversary, strategy, &trace);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "BENCH adversary " << (mode == LARGEST_BUCKET ? "largest" : "hardest") << " vs " << name << ": "
+              << guessCount(trace) << " guesses, " << us << " us" << std::endl;
+  };
+
+  for (AdversaryMode mode : {LARGEST_BUCKET, HARDEST_BUCKET}) {
+    run("overlap", OverlapStrategy{}, mode);
+    run("tiered", dictionary->strategy(), mode);
+    run("tiered partition<=1000", TieredStrategy{TierThresholds{20, 1000}, index.words()}, mode);
+  }
+}
+
+TEST_CASE("AnytimeStrategy_budgetAndSeed", "[strategy]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  auto scorer = std::make_shared<const PartitionScorer>(index.words());
+  std::vector<ScoredGuess> exact = scorer->topGuesses(index.words(), 1);
+
+  /*     a budget covering the whole set is exact scoring     */
+  AnytimeReport report;
+  AnytimeStrategy unlimited{scorer, AnytimeBudget{std::numeric_limits<size_t>::max(), std::chrono::seconds{60}}};
+  REQUIRE(unlimited.choose(index.words(), &report) == scorer->word(exact.front().guess));
+  REQUIRE(report.exact);
+
+  /*     sampled + refined: same guess every time for a fixed seed, never better than exact     */
+  AnytimeBudget budget{size_t{1} << 20, std::chrono::seconds{60}, 128, 32, 7};
+  AnytimeStrategy sampled{scorer, budget};
+  std::string first = sampled.choose(index.words(), &report);
+  REQUIRE_FALSE(report.exact);
+  REQUIRE_FALSE(report.deadlineHit);
+  REQUIRE(report.refined > 0);
+  REQUIRE(report.score >= exact.front().score);
+  REQUIRE(report.pairs <= budget.maxPairs);
+  REQUIRE(sampled.choose(index.words()) == first);
+
+  /*     the sample shrinks to fit maxPairs, and an expired deadline stops the first pass     */
+  AnytimeStrategy tight{scorer, AnytimeBudget{scorer->size() * 40, std::chrono::seconds{60}, 256, 32, 7}};
+  tight.choose(index.words(), &report);
+  REQUIRE(report.sampled == 40);
+  REQUIRE(report.pairs <= scorer->size() * 40);
+  AnytimeStrategy late{scorer, AnytimeBudget{size_t{1} << 20, std::chrono::microseconds{0}}};
+  REQUIRE(index.id(late.choose(index.words(), &report)) != kInvalidWordId);
+  REQUIRE(report.deadlineHit);
+  REQUIRE(report.refined == 0);
+
+  std::mt19937 rng(testSeed());
+  std::string answer = getRandomWord(index, rng);
+  Wordle wordle{answer};
+  REQUIRE(SolveWordle(wordle, sampled) == answer);
+}
+
+/*     how close the anytime guess gets to exact scoring, per budget: ./wordle "[benchmark]"     */
+TEST_CASE("AnytimeStrategy_closeness", "[.][benchmark]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  auto scorer = std::make_shared<const PartitionScorer>(index.words());
+  std::mt19937 rng(testSeed());
+
+  /*     root set plus the sets left after "slate" for a few answers     */
+  std::vector<std::vector<std::string>> sets{index.words()};
+  for (int i = 0; i < 8; ++i) {
+    FeedbackCode code = computeFeedback("slate", getRandomWord(index, rng));
+    std::vector<std::string> left;
+    for (const std::string & word : index.words()) {
+      if (computeFeedback("slate", word) == code) left.push_back(word);
+    }
+    sets.push_back(left);
+  }
+
+  for (size_t maxPairs : {size_t{1} << 18, size_t{1} << 20, size_t{1} << 22}) {
+    double worstRatio = 1.0;
+    double totalRatio = 0.0;
+    size_t totalUs = 0;
+    for (const auto & words : sets) {
+      uint64_t best = scorer->topGuesses(words, 1).front().score;
+      AnytimeReport report;
+      auto start = std::chrono::steady_clock::now();
+      std::string guess = AnytimeStrategy{scorer, AnytimeBudget{maxPairs, std::chrono::milliseconds{50}}}.choose(words, &report);
+      totalUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+      std::vector<PackedWord> packed;
+      for (const std::string & word : words) packed.push_back(packWord(word));
+      double ratio = double(partitionScore(packWord(guess), packed)) / best;
+      worstRatio = std::max(worstRatio, ratio);
+      totalRatio += ratio;
+    }
+    std::cout << "BENCH anytime pairs<=" << maxPairs << ": score/exact mean " << totalRatio / sets.size()
+              << ", worst " << worstRatio << ", " << totalUs / sets.size() << " us/move" << std::endl;
+  }
+}
+
+/*==================*/
+/* WORD LIST INGEST */
+/*==================*/
+TEST_CASE("LoadWordBuckets_normalizes", "[ingest]") {
+  const std::string path = "wordle_ingest_test.txt";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "Slate\r\nCRANE\r\n  crane \n\nab\nit's\nnaïve\nNAÏVE\nzebra\r\nextraordinarily\nExtraordinarily\nslate";
+  }
+
+  for (size_t threads : {1, 4}) {
+    Alphabet letters;
+    WordBuckets buckets = loadWordBuckets(path, letters, threads, 1);
+    REQUIRE(buckets.size() == 3);
+    REQUIRE(buckets[2] == std::vector<std::string>{"ab"});
+    REQUIRE(buckets[5] == std::vector<std::string>{"crane", encodeWord("naïve", letters), "slate", "zebra"});
+    REQUIRE(buckets[15] == std::vector<std::string>{"extraordinarily"});
+  }
+
+  Alphabet letters;
+  REQUIRE(loadWordBuckets("wordle_missing_file.txt", letters).empty());
+  REQUIRE(letters.size() == kAsciiLetters);
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Alphabet_foldsUtf8Letters", "[ingest]") {
+  const std::string path = "wordle_alphabet_test.txt";
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "Ärger\näRGER\nÉCLAT\nstraße\nНОЧЬ\nночь\nслово\nhello\nit's\nȘOȘEA\n";
+  }
+
+  /*     one byte per letter, dense codes past a-z, UTF-8 again on the way out     */
+  Alphabet letters;
+  WordBuckets buckets = loadWordBuckets(path, letters, 2, 1);
+  std::vector<std::string> five{encodeWord("ärger", letters), encodeWord("éclat", letters), "hello", encodeWord("слово", letters), encodeWord("șoșea", letters)};
+  std::sort(five.begin(), five.end());
+  REQUIRE(buckets[5] == five);
+  REQUIRE(buckets[4] == std::vector<std::string>{encodeWord("ночь", letters)});
+  REQUIRE(buckets[6] == std::vector<std::string>{encodeWord("straße", letters)});
+  REQUIRE(decodeWord(encodeWord("слово", letters), letters) == "слово");
+  REQUIRE(encodeWord("ÄRGER", letters) == encodeWord("ärger", letters));
+  REQUIRE_THROWS_AS(encodeWord("it's", letters), std::logic_error);
+  REQUIRE_THROWS_AS(encodeWord("ωμέγα", letters), std::logic_error);
+
+  REQUIRE(letterCode('a') == 0);
+  REQUIRE(letterCode('z') == 25);
+  REQUIRE(letterCode('S') == kNoLetter);
+  REQUIRE(letters.size() > kAsciiLetters);
+  REQUIRE(letters.size() <= kMaxLetters);
+  for (const std::string & word : buckets[5]) {
+    for (char unit : word) REQUIRE(letters.has(unit));
+  }
+
+  /*     Latin Extended-B folds like the blocks before it     */
+  REQUIRE(foldLetter(0x218) == 0x219); // Ș
+  REQUIRE(foldLetter(0x1cd) == 0x1ce); // Ǎ
+  REQUIRE(foldLetter(0x1c4) == 0x1c6); // Ǆ
+  REQUIRE(foldLetter(0x18f) == 0x259); // Ə
+  REQUIRE(foldLetter(0x259) == 0x259);
+  REQUIRE(foldLetter(0x2b0) == 0);
+
+  /*     Greek and Cyrillic capitals past the basic alphabets fold too, their punctuation and combining marks aren't letters     */
+  REQUIRE(foldLetter(0x386) == 0x3ac); // Ά
+  REQUIRE(foldLetter(0x38f) == 0x3ce); // Ώ
+  REQUIRE(foldLetter(0x3aa) == 0x3ca); // Ϊ
+  REQUIRE(foldLetter(0x3ab) == 0x3cb); // Ϋ
+  REQUIRE(foldLetter(0x3da) == 0x3db); // Ϛ
+  REQUIRE(foldLetter(0x3ac) == 0x3ac);
+  REQUIRE(foldLetter(0x490) == 0x491); // Ґ
+  REQUIRE(foldLetter(0x491) == 0x491);
+  REQUIRE(foldLetter(0x460) == 0x461); // Ѡ
+  REQUIRE(foldLetter(0x4d8) == 0x4d9); // Ә
+  REQUIRE(foldLetter(0x4c1) == 0x4c2); // Ӂ
+  REQUIRE(foldLetter(0x4c0) == 0x4cf); // Ӏ
+  for (uint32_t mark : {0x37eu, 0x384u, 0x385u, 0x387u, 0x3a2u, 0x482u, 0x483u, 0x487u, 0x489u}) REQUIRE(foldLetter(mark) == 0);
+
+  /*     only well-formed UTF-8 decodes: overlong forms of letters and lead bytes past F4 don't     */
+  auto decodeAll = [](const std::string & bytes) {
+    const char * c = bytes.data();
+    return decodeLetter(c, bytes.data() + bytes.size());
+  };
+  REQUIRE(decodeAll("\xc3\x84") == 0xe4); // Ä
+  REQUIRE(decodeAll("\xd2\x90") == 0x491); // Ґ
+  REQUIRE(decodeAll("\xc1\x81") == 0); // overlong 'A'
+  REQUIRE(decodeAll("\xc0\xa1") == 0);
+  REQUIRE(decodeAll("\xe0\x81\x81") == 0);
+  REQUIRE(decodeAll("\xe0\x83\x84") == 0); // overlong Ä
+  REQUIRE(decodeAll("\xf0\x80\x83\x84") == 0);
+  REQUIRE(decodeAll("\xed\xa0\x80") == 0); // surrogate
+  REQUIRE(decodeAll("\xf5\x80\x80\x80") == 0);
+  REQUIRE(decodeAll("\xff") == 0);
+  {
+    const std::string mixed = "wordle_alphabet_mixed.txt";
+    std::ofstream(mixed, std::ios::binary) << "ҐАНОК\nґанок\nΆΓΙΟΣ\nάγιοσ\nκαλά\u037e\nа\u0483бвг\n";
+    Alphabet own;
+    WordBuckets folded = loadWordBuckets(mixed, own, 1, 1);
+    std::remove(mixed.c_str());
+    std::vector<std::string> expected{encodeWord("ґанок", own), encodeWord("άγιοσ", own)};
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(folded[5] == expected);
+    REQUIRE(folded.count(4) == 0);
+  }
+
+  /*     a localized list plays like English, opening with one of its own words     */
+  const std::shared_ptr<const DictionaryEpoch> before = currentDictionary();
+  const std::shared_ptr<const DictionaryEpoch> localized = reloadDictionary(std::unordered_set<std::string>(five.begin(), five.end()), letters);
+  REQUIRE(localized->contains(localized->openingGuess()));
+  TieredStrategy strategy{TierThresholds{}, five};
+  for (const std::string & answer : five) {
+    Wordle wordle{answer};
+    REQUIRE(SolveWordle(wordle, strategy) == answer);
+    REQUIRE(SolveWordle(wordle) == answer);
+  }
+
+  /*     words that aren't 5 letters of the epoch's alphabet never make it into an epoch     */
+  REQUIRE_THROWS_AS(reloadDictionary(std::unordered_set<std::string>{"Slate", "crane"}), std::logic_error);
+  REQUIRE_THROWS_AS(reloadDictionary(std::unordered_set<std::string>{"slat", "crane"}), std::logic_error);
+  REQUIRE_THROWS_AS(reloadDictionary(std::unordered_set<std::string>{"crane", std::string(5, static_cast<char>(0xbf))}), std::logic_error);
+  REQUIRE(currentDictionary() == localized);
+
+  /*     Greek then Cyrillic don't fit in one alphabet: the second list starts its own, a third one extends it     */
+  const std::string greek = "wordle_alphabet_greek.txt";
+  const std::string cyrillic = "wordle_alphabet_cyrillic.txt";
+  const std::string latin = "wordle_alphabet_latin.txt";
+  std::ofstream(greek, std::ios::binary) << "αβγδε\nζηθικ\nλμνξο\nπρστυ\nφχψωα\n";
+  std::ofstream(cyrillic, std::ios::binary) << "абвгд\nеёжзи\nйклмн\nопрст\nуфхцч\nшщъыь\nэюяаб\n";
+  std::ofstream(latin, std::ios::binary) << "ärger\néclat\nfaçon\nабвгд\n";
+
+  auto greekEpoch = reloadDictionary(greek);
+  REQUIRE(greekEpoch->words().size() == 5);
+  auto cyrillicEpoch = reloadDictionary(cyrillic);
+  REQUIRE(cyrillicEpoch->words().size() == 7);
+  REQUIRE(cyrillicEpoch->alphabet().size() == kAsciiLetters + 33);
+  REQUIRE(cyrillicEpoch->contains(cyrillicEpoch->openingGuess())); // frequency pick over codes past a-z
+  SolverState cyrillicState;
+  cyrillicState.possibleAnswers = cyrillicEpoch->words();
+  REQUIRE(PositionalFrequencyStrategy{}.nextGuess(cyrillicState) == cyrillicEpoch->openingGuess()); // histograms sized from the codes in use match the alphabet's
+  auto latinEpoch = reloadDictionary(latin);
+  REQUIRE(latinEpoch->alphabet().size() == kAsciiLetters + 36);
+  REQUIRE(latinEpoch->contains(encodeWord("абвгд", cyrillicEpoch->alphabet())));
+  for (const auto & epoch : {greekEpoch, cyrillicEpoch, latinEpoch}) {
+    for (const std::string & answer : epoch->words()) {
+      REQUIRE(encodeWord(decodeWord(answer, epoch->alphabet()), epoch->alphabet()) == answer);
+      REQUIRE(solveGame(EpochWordle{answer, epoch}, epoch->strategy(), nullptr) == answer);
+    }
+  }
+
+  /*     what gets printed is the word in UTF-8, not its letter codes     */
+  std::ostringstream printed;
+  std::streambuf * stdoutBuffer = std::cout.rdbuf(printed.rdbuf());
+  const std::string answer = encodeWord("эюяаб", cyrillicEpoch->alphabet());
+  solveGame(EpochWordle{answer, cyrillicEpoch}, cyrillicEpoch->strategy(), nullptr);
+  std::cout.rdbuf(stdoutBuffer);
+  REQUIRE(printed.str() == "Word: эюяаб\n");
+
+  reloadDictionary(before->words(), before->alphabet());
+  for (const std::string & file : {path, greek, cyrillic, latin}) std::remove(file.c_str());
+}
+
+TEST_CASE("LoadWordBuckets_chunksMatchReference", "[ingest]") {
+  const std::string path = "wordle_ingest_large.txt";
+  std::mt19937 rng(testSeed());
+  std::map<size_t, std::set<std::string>> expected;
+  {
+    std::ofstream out(path, std::ios::binary);
+    for (int i = 0; i < 50000; ++i) {
+      size_t length = 1 + rng() % 16;
+      std::string word;
+      for (size_t idx = 0; idx < length; ++idx) word.push_back(static_cast<char>('a' + rng() % 4));
+      expected[length].insert(word);
+      if (rng() % 3 == 0) word[0] = static_cast<char>(word[0] - 'a' + 'A');
+      out << word << (rng() % 2 ? "\r\n" : "\n");
+    }
+  }
+
+  Alphabet letters;
+  WordBuckets buckets = loadWordBuckets(path, letters, 4, 64);
+  REQUIRE(buckets.size() == expected.size());
+  for (const auto & entry : expected) {
+    REQUIRE(buckets[entry.first] == std::vector<std::string>(entry.second.begin(), entry.second.end()));
+  }
+  std::remove(path.c_str());
+}
+
+/*===================*/
+/* DICTIONARY RELOAD */
+/*===================*/
+TEST_CASE("DictionaryEpoch_reload", "[dictionary]") {
+  const std::shared_ptr<const DictionaryEpoch> before = currentDictionary();
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+
+  /*     warm a few opening buckets, then drop one word and add one that isn't in the list     */
+  std::string answer = getRandomWord(index, rng);
+  while (answer == kOpeningGuess) answer = getRandomWord(index, rng);
+  Wordle inFlight{answer};
+  REQUIRE(SolveWordle(Wordle{answer}) == answer);
+  REQUIRE(before->openingGuess() == kOpeningGuess);
+  for (const char * word : {"crane", "plate", "zebra", "pross"}) before->afterOpening(computeFeedback(kOpeningGuess, word));
+
+  /*     an opening the diff doesn't touch whose memoized second guess is a probe outside it; that probe gets removed too     */
+  const std::string added = "zqxjv";
+  std::shared_ptr<const OpeningBucket> probed;
+  std::string probe;
+  for (size_t code = 0; code < kNumFeedbackCodes && probed == nullptr; ++code) {
+    auto bucket = before->afterOpening(static_cast<FeedbackCode>(code));
+    if (bucket->state.possibleAnswers.size() <= 1 || bucket->state.possibleAnswers.count(answer) != 0 || computeFeedback(kOpeningGuess, added) == code) continue;
+    std::string guess = bucket->nextGuess(before->strategy(), bucket->state);
+    if (bucket->state.possibleAnswers.count(guess) == 0 && guess != answer && guess != kOpeningGuess) {
+      probed = bucket;
+      probe = guess;
+    }
+  }
+  REQUIRE(probed != nullptr);
+  const std::string probedAnswer = *probed->state.possibleAnswers.begin();
+
+  REQUIRE_FALSE(before->contains(added));
+  std::unordered_set<std::string> words = before->words();
+  words.erase(answer);
+  words.erase(probe);
+  words.insert(added);
+  const std::shared_ptr<const DictionaryEpoch> after = reloadDictionary(words);
+  REQUIRE(currentDictionary() == after);
+  REQUIRE(after->epoch() == before->epoch() + 1);
+
+  /*     the game that started before the reload still plays by the old list, new games don't     */
+  REQUIRE_NOTHROW(inFlight.CharacterizeWord(answer));
+  REQUIRE_THROWS_AS(Wordle{"slate"}.CharacterizeWord(answer), std::logic_error);
+  REQUIRE_NOTHROW(Wordle{"slate"}.CharacterizeWord(added));
+
+  /*     untouched openings are shared, touched ones match a build from scratch     */
+  DictionaryEpoch fresh{words, 0, after->alphabet()};
+  size_t shared = 0;
+  for (size_t code = 0; code < kNumFeedbackCodes; ++code) {
+    auto kept = after->afterOpening(static_cast<FeedbackCode>(code));
+    REQUIRE(kept->state.possibleAnswers == fresh.afterOpening(static_cast<FeedbackCode>(code))->state.possibleAnswers);
+    if (kept == before->afterOpening(static_cast<FeedbackCode>(code))) shared++;
+  }
+  REQUIRE(shared > 0);
+  REQUIRE(shared < kNumFeedbackCodes);
+  REQUIRE(after->afterOpening(computeFeedback(kOpeningGuess, answer)) != before->afterOpening(computeFeedback(kOpeningGuess, answer)));
+
+  Wordle newWord{added};
+  REQUIRE(SolveWordle(newWord) == added);
+
+  /*     the probed opening is still shared, without the removed probe; new games score the new list     */
+  REQUIRE(after->afterOpening(computeFeedback(kOpeningGuess, probedAnswer)) == probed);
+  for (const auto & memo : probed->nextGuesses) REQUIRE(memo.second != probe);
+  REQUIRE(SolveWordle(Wordle{probedAnswer}) == probedAnswer);
+  REQUIRE(after->strategy().scorer()->ids({added}));
+  REQUIRE_FALSE(after->strategy().scorer()->ids({probe}));
+  REQUIRE(after->index().words() == WordIndex{words}.words());
+  REQUIRE(after->index().id(added) == after->index().words().size() - 1);
+  REQUIRE(after->index().id(answer) == kInvalidWordId);
+
+  /*     the strategy was built before the reload, so the new one is the old scorer patched: same words, same packing     */
+  const PartitionScorer & scorer = *after->strategy().scorer();
+  REQUIRE(scorer.size() == after->index().size());
+  for (uint32_t id = 0; id < scorer.size(); ++id) {
+    REQUIRE(scorer.word(id) == after->index().word(id));
+    REQUIRE(scorer.packed(id) == packWord(after->index().word(id)));
+  }
+  REQUIRE(scorer.ids({added, probedAnswer}) == PartitionScorer{after->index().words()}.ids({added, probedAnswer}));
+
+  /*     traces only take games played on the header's dictionary; a writer over the current one takes the added word     */
+  const std::string tracePath = "wordle_reload_trace.bin";
+  std::remove(tracePath.c_str());
+  GameTrace trace;
+  REQUIRE(SolveWordle(Wordle{added}, &trace) == added);
+  REQUIRE(trace.dictionary == after->index().fingerprint());
+  trace.answer = after->index().id(added);
+  {
+    TraceWriter writer{tracePath, index};
+    REQUIRE_THROWS_AS(writer.append(trace), std::logic_error);
+  }
+  std::remove(tracePath.c_str());
+  {
+    TraceWriter writer{tracePath, currentDictionary()->index()};
+    REQUIRE_NOTHROW(writer.append(trace));
+  }
+  REQUIRE(readTrace(tracePath, after->index()).size() == 1);
+  std::remove(tracePath.c_str());
+
+  /*     kept words are only checked again under an alphabet that doesn't extend the old one     */
+  Alphabet latin;
+  REQUIRE(after->alphabet().extends(latin));
+  Alphabet other;
+  other.add(0xe9);
+  REQUIRE(other.extends(latin));
+  REQUIRE_FALSE(latin.extends(other));
+
+  reloadDictionary(before->words(), before->alphabet());
+  REQUIRE(currentDictionary()->words() == before->words());
+}
+
+/*==================*/
+/* PIPELINED SOLVER */
+/*==================*/
+TEST_CASE("PipelinedSolver_slowOracle", "[pipeline]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  std::vector<std::string> answers;
+  for (int i = 0; i < 200; ++i) answers.push_back(getRandomWord(index, rng));
+
+  const auto latency = std::chrono::milliseconds(10);
+  LatencyOracle oracle{answers, latency, std::chrono::milliseconds(2), static_cast<unsigned>(rng())};
+  PipelineScheduler scheduler{oracle, PipelineConfig{2, 128, 4096}};
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::string> solved = scheduler.solveAll(answers.size());
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  REQUIRE(solved == answers);
+  REQUIRE(oracle.batches() < oracle.requests());
+
+  /*     blocking on every guess would take requests * latency     */
+  REQUIRE(elapsed < oracle.requests() * latency / 4);
+}
+
+TEST_CASE("PipelinedSolver_boundedInFlight", "[pipeline]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  std::mt19937 rng(testSeed());
+  std::vector<std::string> answers;
+  for (int i = 0; i < 40; ++i) answers.push_back(getRandomWord(index, rng));
+
+  LatencyOracle oracle{answers, std::chrono::microseconds(500), std::chrono::microseconds(500), static_cast<unsigned>(rng())};
+  PipelineScheduler scheduler{oracle, PipelineConfig{3, 4, 8}};
+  REQUIRE(scheduler.solveAll(answers.size()) == answers);
+}
+
+TEST_CASE("PipelinedSolver_invalidFeedback", "[pipeline]") {
+  /*     oracle doesn't know game 0 -> INVALID feedback, failure surfaces from solveAll     */
+  LatencyOracle oracle{{}, std::chrono::microseconds(100), std::chrono::microseconds(0), 1};
+  PipelineScheduler scheduler{oracle};
+  REQUIRE_THROWS_AS(scheduler.solveAll(1), std::logic_error);
+}
+
+/*===============*/
+/* SHARDED SWEEP */
+/*===============*/
+TEST_CASE("ShardedSweep_localWorkers", "[sweep]") {
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  const size_t numAnswers = std::min<size_t>(index.size(), 120);
+  const std::vector<TierThresholds> configs = {TierThresholds{20, 100, 16, false}, TierThresholds{0, 0, 0, false}, TierThresholds{8, 100, 4, true}, TierThresholds{20, 100, 16, false, ENTROPY_POLICY}};
+  const std::string tablesPath = "wordle_sweep_tables.bin";
+  writeSweepTables(tablesPath, index);
+  currentDictionary()->strategy(); // build statics + epoch caches before forking
+
+  /*     the mapped table is the feedback, and scoring out of it ranks like computing it     */
+  {
+    auto tables = std::make_shared<const SweepTables>(tablesPath);
+    REQUIRE(tables->size() == index.size());
+    std::mt19937 rng{testSeed()};
+    std::uniform_int_distribution<WordId> pick(0, static_cast<WordId>(index.size() - 1));
+    for (size_t sample = 0; sample < 200; ++sample) {
+      WordId guess = pick(rng);
+      WordId answer = pick(rng);
+      REQUIRE(tables->feedback()[size_t{guess} * index.size() + answer] == computeFeedback(index.word(guess), index.word(answer)));
+    }
+
+    PartitionScorer computed{index.words()};
+    PartitionScorer mapped{tables->words(), std::shared_ptr<const FeedbackCode>(tables, tables->feedback())};
+    std::vector<std::string> candidates(index.words().begin(), index.words().begin() + std::min<size_t>(index.size(), 60));
+    auto expectedTop = computed.topGuesses(candidates, 5);
+    auto mappedTop = mapped.topGuesses(candidates, 5);
+    REQUIRE(mappedTop.size() == expectedTop.size());
+    for (size_t idx = 0; idx < expectedTop.size(); ++idx) {
+      REQUIRE(mappedTop[idx].guess == expectedTop[idx].guess);
+      REQUIRE(mappedTop[idx].score == expectedTop[idx].score);
+    }
+  }
+
+  /*     expected: the same sweep in this process     */
+  std::vector<SweepResult> expected;
+  for (const TierThresholds & config : configs) {
+    TieredStrategy strategy{config, index.words()};
+    expected.push_back(solveSweepRange(strategy, [&](WordId id) { return index.word(id); }, 0, static_cast<WordId>(numAnswers)));
+  }
+
+  for (const std::string & endpoint : {std::string{"unix:wordle_sweep_test.sock"}, std::string{"tcp:127.0.0.1:0"}}) {
+    SweepOptions options;
+    options.endpoint = endpoint;
+    options.shardSize = 10;
+    options.shardTimeout = std::chrono::seconds(5);
+    options.idleTimeout = std::chrono::seconds(20);
+    SweepCoordinator coordinator{configs, numAnswers, options};
+
+    /*     three healthy workers + one that dies on its first shard + one that garbles its second result     */
+    std::vector<pid_t> workers;
+    for (SweepWorkerOptions workerOptions : {SweepWorkerOptions{}, SweepWorkerOptions{}, SweepWorkerOptions{}, SweepWorkerOptions{1, 0}, SweepWorkerOptions{0, 2}}) {
+      pid_t pid = ::fork();
+      REQUIRE(pid >= 0);
+      if (pid == 0) {
+        std::cout.setstate(std::ios::failbit);
+        ::_exit(runSweepWorker(coordinator.endpoint(), tablesPath, workerOptions));
+      }
+      workers.push_back(pid);
+    }
+
+    std::vector<SweepResult> results = coordinator.run();
+    for (pid_t pid : workers) ::waitpid(pid, nullptr, 0);
+
+    REQUIRE(results.size() == configs.size());
+    for (size_t config = 0; config < configs.size(); ++config) {
+      REQUIRE(results[config].games == numAnswers);
+      REQUIRE(results[config].failures == 0);
+      REQUIRE(results[config].histogram == expected[config].histogram);
+      REQUIRE(results[config].worstGuesses == expected[config].worstGuesses);
+      REQUIRE(results[config].worstAnswers == expected[config].worstAnswers);
+    }
+  }
+
+  std::remove(tablesPath.c_str());
+}
+
+/*=======*/
+/* C ABI */
+/*=======*/
+TEST_CASE("CApi_batchCalls", "[capi]") {
+  const std::shared_ptr<const DictionaryEpoch> epoch = currentDictionary();
+  const WordIndex & index = epoch->index();
+  wordle_dictionary * dictionary = wordle_dictionary_current();
+  REQUIRE(dictionary != nullptr);
+  REQUIRE(wordle_dictionary_size(dictionary) == index.size());
+  REQUIRE(wordle_dictionary_id(dictionary, "slate") == index.id("slate"));
+  REQUIRE(wordle_dictionary_id(dictionary, "qqqqq") == WORDLE_INVALID_ID);
+
+  char word[16];
+  REQUIRE(wordle_dictionary_word(dictionary, index.id("slate"), word, sizeof(word)) == 0);
+  REQUIRE(std::string{word} == "slate");
+  REQUIRE(wordle_dictionary_word(dictionary, index.id("slate"), word, 3) == -1);
+  REQUIRE(std::string{wordle_last_error()}.find("too small") != std::string::npos);
+
+  /*     feedback over caller arrays matches computeFeedback()     */
+  std::mt19937 rng(testSeed());
+  std::vector<uint32_t> guesses(64);
+  std::vector<uint32_t> answers(64);
+  std::vector<uint8_t> feedback(64);
+  for (size_t idx = 0; idx < guesses.size(); ++idx) {
+    guesses[idx] = index.id(getRandomWord(index, rng));
+    answers[idx] = index.id(getRandomWord(index, rng));
+  }
+  REQUIRE(wordle_feedback(dictionary, guesses.data(), answers.data(), guesses.size(), feedback.data()) == 0);
+  for (size_t idx = 0; idx < guesses.size(); ++idx) {
+    REQUIRE(feedback[idx] == computeFeedback(index.word(guesses[idx]), index.word(answers[idx])));
+  }
+  uint32_t outOfRange = static_cast<uint32_t>(index.size());
+  REQUIRE(wordle_feedback(dictionary, &outOfRange, answers.data(), 1, feedback.data()) == -1);
+
+  /*     batch solve agrees with SolveWordle(), and replaying its guesses gives the same next guesses     */
+  wordle_solver * solver = wordle_solver_create(dictionary, WORDLE_POLICY_EXPECTED_SIZE);
+  REQUIRE(solver != nullptr);
+  wordle_dictionary_free(dictionary);
+  std::vector<uint32_t> used(8);
+  std::vector<uint32_t> solved(8);
+  REQUIRE(wordle_solve(solver, answers.data(), used.size(), used.data(), solved.data()) == 0);
+  for (size_t idx = 0; idx < used.size(); ++idx) {
+    Wordle wordle{index.word(answers[idx])};
+    GameTrace trace;
+    REQUIRE(SolveWordle(wordle, &trace) == index.word(answers[idx]));
+    REQUIRE(solved[idx] == answers[idx]);
+    REQUIRE(used[idx] == guessCount(trace));
+
+    std::vector<uint32_t> history;
+    std::vector<uint8_t> codes;
+    for (const TraceStep & step : trace.steps) {
+      uint32_t next = WORDLE_INVALID_ID;
+      REQUIRE(wordle_next_guess(solver, history.data(), codes.data(), history.size(), &next) == 0);
+      REQUIRE(next == step.guess);
+      history.push_back(step.guess);
+      codes.push_back(step.feedback);
+    }
+  }
+
+  /*     concurrent batches each borrow a buffer from the solver and hand it back     */
+  std::vector<std::thread> batches;
+  std::vector<std::vector<uint32_t>> batchUsed(4, std::vector<uint32_t>(used.size()));
+  std::vector<std::vector<uint32_t>> batchSolved(4, std::vector<uint32_t>(used.size()));
+  for (size_t batch = 0; batch < batchUsed.size(); ++batch) {
+    batches.emplace_back([&, batch]() { wordle_solve(solver, answers.data(), used.size(), batchUsed[batch].data(), batchSolved[batch].data()); });
+  }
+  for (std::thread & batch : batches) batch.join();
+  for (size_t batch = 0; batch < batchUsed.size(); ++batch) {
+    REQUIRE(batchUsed[batch] == used);
+    REQUIRE(batchSolved[batch] == solved);
   }
+  REQUIRE(solver->spareGames.size() == solver->numGames);
+  REQUIRE(solver->numGames <= batchUsed.size());
+
+  /*     a resumable game in a caller buffer plays the same guesses, one step at a time     */
+  std::vector<uint64_t> game((wordle_game_size(solver) + 7) / 8);
+  const size_t capacity = game.size() * 8;
+  for (size_t idx = 0; idx < used.size(); ++idx) {
+    Wordle wordle{index.word(answers[idx])};
+    GameTrace trace;
+    SolveWordle(wordle, &trace);
+    uint32_t next = WORDLE_INVALID_ID;
+    REQUIRE(wordle_game_start(solver, game.data(), capacity, &next) == 0);
+    for (const TraceStep & step : trace.steps) {
+      REQUIRE(next == step.guess);
+      REQUIRE(wordle_game_step(solver, game.data(), capacity, step.guess, step.feedback, &next) == 0);
+    }
+    REQUIRE(next == answers[idx]);
+  }
+
+  /*     every policy's game handle follows the C++ strategy, overlap ties included     */
+  for (int policy : {WORDLE_POLICY_ENTROPY, WORDLE_POLICY_MINIMAX, WORDLE_POLICY_OVERLAP}) {
+    wordle_dictionary * handle = wordle_dictionary_current();
+    wordle_solver * policySolver = wordle_solver_create(handle, policy);
+    wordle_dictionary_free(handle);
+    TierThresholds thresholds;
+    thresholds.partitionPolicy = static_cast<ScoringPolicy>(policy);
+    TieredStrategy strategy{thresholds, index.words()};
+    for (size_t idx = 0; idx < used.size(); ++idx) {
+      GameTrace trace;
+      REQUIRE(SolveWordle(Wordle{index.word(answers[idx])}, strategy, &trace) == index.word(answers[idx]));
+      uint32_t next = WORDLE_INVALID_ID;
+      REQUIRE(wordle_game_start(policySolver, game.data(), capacity, &next) == 0);
+      for (const TraceStep & step : trace.steps) {
+        REQUIRE(next == step.guess);
+        REQUIRE(wordle_game_step(policySolver, game.data(), capacity, step.guess, step.feedback, &next) == 0);
+      }
+    }
+    wordle_solver_free(policySolver);
+  }
+
+  uint32_t next = WORDLE_INVALID_ID;
+  REQUIRE(wordle_game_size(solver) >= index.size() * sizeof(uint32_t));
+  REQUIRE(wordle_game_start(solver, game.data(), capacity - 8 * (game.size() / 2 + 1), &next) == -1);
+  REQUIRE(std::string{wordle_last_error()}.find("too small") != std::string::npos);
+  REQUIRE(wordle_game_start(solver, reinterpret_cast<char *>(game.data()) + 1, capacity - 1, &next) == -1);
+  REQUIRE(wordle_game_start(solver, game.data(), capacity, &next) == 0);
+  REQUIRE(wordle_game_step(solver, game.data(), capacity, next, WORDLE_SOLVED + 1, &next) == -1);
+  wordle_dictionary * current = wordle_dictionary_current();
+  wordle_solver * other = wordle_solver_create(current, WORDLE_POLICY_MINIMAX);
+  REQUIRE(wordle_game_step(other, game.data(), capacity, next, 0, &next) == -1);
+  REQUIRE(std::string{wordle_last_error()}.find("not started by this solver") != std::string::npos);
+  wordle_solver_free(other);
+  wordle_dictionary_free(current);
+  REQUIRE(wordle_solver_create(nullptr, 9) == nullptr);
+
+  /*     NULL handles and buffers are errors, not crashes; empty batches may pass NULL     */
+  uint32_t id = 0;
+  uint8_t code = 0;
+  REQUIRE(wordle_dictionary_size(nullptr) == 0);
+  REQUIRE(std::string{wordle_last_error()}.find("NULL") != std::string::npos);
+  REQUIRE(wordle_dictionary_id(nullptr, "slate") == WORDLE_INVALID_ID);
+  REQUIRE(wordle_dictionary_word(nullptr, 0, word, sizeof(word)) == -1);
+  REQUIRE(wordle_feedback(nullptr, &id, &id, 1, &code) == -1);
+  REQUIRE(wordle_solve(nullptr, &id, 1, &id, &id) == -1);
+  REQUIRE(wordle_solve(solver, nullptr, 1, used.data(), solved.data()) == -1);
+  REQUIRE(wordle_solve(solver, nullptr, 0, nullptr, nullptr) == 0);
+  REQUIRE(wordle_next_guess(nullptr, nullptr, nullptr, 0, &id) == -1);
+  REQUIRE(wordle_next_guess(solver, nullptr, nullptr, 0, nullptr) == -1);
+  REQUIRE(wordle_next_guess(solver, nullptr, &code, 1, &id) == -1);
+  wordle_solver_free(solver);
+  wordle_solver_free(nullptr);
+  wordle_dictionary_free(nullptr);
+}
+
+TEST_CASE("CApi_dictionaryWithoutSlate", "[capi]") {
+  const std::string path = "wordle_capi_words.txt";
+  std::ofstream(path, std::ios::binary) << "crane\nplumb\nfight\nzesty\nwords\nbough\nmixer\nqualm\n";
+  wordle_dictionary * dictionary = wordle_dictionary_load(path.c_str());
+  std::remove(path.c_str());
+  REQUIRE(dictionary != nullptr);
+  REQUIRE(wordle_dictionary_size(dictionary) == 8);
+  REQUIRE(wordle_dictionary_id(dictionary, "slate") == WORDLE_INVALID_ID);
+
+  /*     the opening comes from the list, and every game ends on its answer     */
+  wordle_solver * solver = wordle_solver_create(dictionary, WORDLE_POLICY_ENTROPY);
+  REQUIRE(solver != nullptr);
+  uint32_t opening = WORDLE_INVALID_ID;
+  REQUIRE(wordle_next_guess(solver, nullptr, nullptr, 0, &opening) == 0);
+  REQUIRE(opening < wordle_dictionary_size(dictionary));
+
+  std::vector<uint32_t> answers(wordle_dictionary_size(dictionary));
+  for (uint32_t id = 0; id < answers.size(); ++id) answers[id] = id;
+  std::vector<uint32_t> used(answers.size());
+  std::vector<uint32_t> solved(answers.size());
+  REQUIRE(wordle_solve(solver, answers.data(), answers.size(), used.data(), solved.data()) == 0);
+  REQUIRE(solved == answers);
+  REQUIRE(used[opening] == 1);
+  wordle_solver_free(solver);
+  wordle_dictionary_free(dictionary);
+
+  /*     an empty list has no opening: an error, not WORDLE_INVALID_ID with 0     */
+  const std::shared_ptr<const DictionaryEpoch> before = currentDictionary();
+  reloadDictionary(std::unordered_set<std::string>{});
+  dictionary = wordle_dictionary_current();
+  solver = wordle_solver_create(dictionary, WORDLE_POLICY_EXPECTED_SIZE);
+  reloadDictionary(before->words(), before->alphabet());
+  REQUIRE(solver != nullptr);
+  REQUIRE(wordle_next_guess(solver, nullptr, nullptr, 0, &opening) == -1);
+  REQUIRE(std::string{wordle_last_error()}.find("No guess") != std::string::npos);
+  wordle_solver_free(solver);
+  wordle_dictionary_free(dictionary);
+}
+
+/*     replay tool: WORDLE_TRACE_IN=<file> ./wordle "[replay]"     */
+TEST_CASE("GameTrace_replayFile", "[.][replay]") {
+  const char * tracePath = std::getenv("WORDLE_TRACE_IN");
+  REQUIRE(tracePath != nullptr);
+  const std::shared_ptr<const DictionaryEpoch> dictionary = currentDictionary();
+  const WordIndex & index = dictionary->index();
+  ReplayReport report = replayTrace(readTrace(tracePath, index), index);
+  std::cout << report;
+  CHECK(report.divergences.empty());
+  CHECK(report.failedGames == 0);
 }
 
+#endif // WORDLE_LIBRARY
+
 
 
 
@@ -900,9 +5784,12 @@ std::ostream& operator<<(std::ostream& os, const LetterState& state) {
 
 // ValidateWord(string) -> determines if "word" is in dictionary 
 
+void ValidateWord(const std::string& word, const DictionaryEpoch& dictionary) {
+  if (!dictionary.contains(word)) throw std::logic_error{"Word " + word+ " is not valid."}; 
+}
+
 void ValidateWord(const std::string& word) {
-  static const auto all_words = GetAllValidWords();
-  if (all_words.count(word) == 0) throw std::logic_error{"Word " + word+ " is not valid."}; 
+  ValidateWord(word, *currentDictionary());
 }
 
 void ValidateStates(const WordleLetterStates& states) {
@@ -919,9 +5806,14 @@ std::ostream& operator<<(std::ostream& os, const WordleLetterStates& states) {
 
 WordleLetterStates Wordle::CharacterizeWord(const std::string& query) const {
   counter_++;
-  ValidateWord(query);
-  std::unordered_map<char, size_t> letter_counts;
-  for(char c : true_word_) letter_counts[c]++; 
+  ValidateWord(query, *dictionary_);
+
+  /*     by letter code; units that aren't letters are never counted (epochs reject such words, hand-built answers may have them)     */
+  std::array<uint8_t, kMaxLetters> letter_counts{};
+  for(char c : true_word_) {
+    uint8_t code = letterCode(c);
+    if(code < kMaxLetters) letter_counts[code]++; 
+  }
   WordleLetterStates states;
   states.fill(INVALID);
   
@@ -929,20 +5821,19 @@ WordleLetterStates Wordle::CharacterizeWord(const std::string& query) const {
   for(size_t idx = 0; idx < query.size(); ++idx) {
     if(true_word_[idx] == query[idx]) {
       states[idx] = CORRECT; 
-      auto letter_count_it = letter_counts.find(true_word_[idx]);
-      if(letter_count_it == letter_counts.end()) throw;
-      if(--(letter_count_it->second) == 0u) letter_counts.erase(letter_count_it);
+      uint8_t code = letterCode(query[idx]);
+      if(code < kMaxLetters) letter_counts[code]--;
     }
   }
 
   for(size_t idx = 0; idx < query.size(); ++idx) {
     if(states[idx] == CORRECT) continue; 
-    auto letter_count_it = letter_counts.find(query[idx]); 
-    if(letter_count_it == letter_counts.end()) {
+    uint8_t code = letterCode(query[idx]);
+    if(code >= kMaxLetters || letter_counts[code] == 0u) {
       states[idx] = NOT_CONTAINED; 
     } else {
       states[idx] = CONTAINED; 
-      if(--(letter_count_it->second) == 0u) letter_counts.erase(letter_count_it); 
+      letter_counts[code]--; 
     }
   }
   
@@ -0,0 +1,90 @@
+/*
+  C ABI of the wordle solver (build: see README, "Shared library").
+
+  Handles are opaque and owned by the library; every other buffer is owned by the caller, and
+  batch calls fill it with ids and codes rather than passing strings. Games run on ids: a game's
+  state is its candidate ids, kept in a caller-owned buffer of wordle_game_size() bytes, and every
+  wordle_game_step() narrows them in place from the previous step. The next guess is picked like
+  the C++ solver's default strategy, on the calling thread, and allocates nothing: the endgame's
+  exhaustive search (20 candidates or fewer left, never more than 32) keeps its memo in the game
+  buffer too. wordle_solve() plays a whole batch through one such buffer and wordle_next_guess()
+  replays a history through one; both borrow it from the solver, which allocates a new one only
+  when more calls use it at once than ever before. wordle_next_guess() replays from the start on
+  each call, so a game driven step by step should use wordle_game_step() instead. What does
+  allocate: creating handles, wordle_dictionary_id() and wordle_dictionary_word() (they convert
+  the word), and any call that fails (the error message). Words are identified by their id in a
+  dictionary handle (ids follow the sorted word list), feedback by its packed code: base 3
+  per letter (0 = not contained, 1 = contained, 2 = correct), letter 0 least significant, 242 = solved.
+
+  Calls returning int give 0 on success and -1 on error; calls returning a handle give NULL on
+  error, wordle_dictionary_size() and wordle_game_size() 0 and wordle_dictionary_id()
+  WORDLE_INVALID_ID. A NULL handle or string is an error, and so is a NULL buffer unless its count
+  is 0. wordle_last_error() describes the last error on the calling thread. Handles may be used
+  from several threads at once; a game buffer by one thread at a time.
+*/
+#ifndef WORDLE_H
+#define WORDLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* only these symbols are exported when built with -fvisibility=hidden */
+#if defined(__GNUC__)
+#define WORDLE_API __attribute__((visibility("default")))
+#else
+#define WORDLE_API
+#endif
+
+#define WORDLE_INVALID_ID 0xffffffffu
+#define WORDLE_SOLVED 242
+
+/* scoring objective of the solver's partition tier; ties go to the lowest id, as in the C++ solver */
+enum wordle_policy {
+  WORDLE_POLICY_EXPECTED_SIZE = 0,
+  WORDLE_POLICY_ENTROPY = 1,
+  WORDLE_POLICY_MINIMAX = 2,
+  WORDLE_POLICY_OVERLAP = 3
+};
+
+typedef struct wordle_dictionary wordle_dictionary;
+typedef struct wordle_solver wordle_solver;
+
+WORDLE_API const char * wordle_last_error(void);
+
+/* dictionary: a UTF-8 word list file (5-letter words are used), or the process's current one */
+WORDLE_API wordle_dictionary * wordle_dictionary_load(const char * path);
+WORDLE_API wordle_dictionary * wordle_dictionary_current(void);
+WORDLE_API void wordle_dictionary_free(wordle_dictionary * dictionary);
+WORDLE_API uint32_t wordle_dictionary_size(const wordle_dictionary * dictionary);
+WORDLE_API uint32_t wordle_dictionary_id(const wordle_dictionary * dictionary, const char * word); /* WORDLE_INVALID_ID if absent */
+WORDLE_API int wordle_dictionary_word(const wordle_dictionary * dictionary, uint32_t id, char * out, size_t capacity); /* NUL-terminated UTF-8 */
+
+/* feedback[i] = feedback of guesses[i] against answers[i] */
+WORDLE_API int wordle_feedback(const wordle_dictionary * dictionary, const uint32_t * guesses, const uint32_t * answers, size_t count, uint8_t * feedback);
+
+/* solver over a dictionary, every word an allowed guess; the dictionary handle may be freed afterwards */
+WORDLE_API wordle_solver * wordle_solver_create(const wordle_dictionary * dictionary, int policy);
+WORDLE_API void wordle_solver_free(wordle_solver * solver);
+
+/* plays every answers[i] to the end, opening with the dictionary's own opening guess: guesses_used[i] = guesses taken, solved[i] = id it finished on */
+WORDLE_API int wordle_solve(const wordle_solver * solver, const uint32_t * answers, size_t count, uint32_t * guesses_used, uint32_t * solved);
+
+/* next guess of a game so far: "steps" guesses (ids) and the feedback each got, replayed from the start; with 0 steps, the opening guess */
+WORDLE_API int wordle_next_guess(const wordle_solver * solver, const uint32_t * guesses, const uint8_t * feedback, size_t steps, uint32_t * next);
+
+/* resumable game: "game" is a caller-owned buffer of at least wordle_game_size() bytes, aligned like uint64_t (malloc'd memory is) */
+WORDLE_API size_t wordle_game_size(const wordle_solver * solver);
+/* (re)starts a game in "game": next = the opening guess */
+WORDLE_API int wordle_game_start(const wordle_solver * solver, void * game, size_t capacity, uint32_t * next);
+/* "guess" got "feedback": narrows the game's candidates, next = the guess to play after it (the guess itself once feedback is WORDLE_SOLVED) */
+WORDLE_API int wordle_game_step(const wordle_solver * solver, void * game, size_t capacity, uint32_t guess, uint8_t feedback, uint32_t * next);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WORDLE_H */